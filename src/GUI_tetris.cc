@@ -9,8 +9,14 @@ int main(int argc, char* argv[]) {
 
   board_t board = {
       .board = {},           // Zero initialize board
+      .rows = {},            // Zero initialize row masks
+      .heights = {},         // Empty columns
+      .holes = {},           // No holes
+      .cleared_rows = 0,     // No rows cleared yet
+      .dirty_rows = 0,       // Marked by init_board()
       .tetramino_curr = {},  // Zero initialize tetramino_curr
-      .tetramino_next = {}   // Zero initialize tetramino_next
+      .tetramino_next = {},  // Zero initialize tetramino_next
+      .randomizer = {}       // Seeded by init_board()
   };
   init_board(&board);
 
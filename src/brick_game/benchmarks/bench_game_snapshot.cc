@@ -0,0 +1,143 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "../game_clock.h"
+#include "../game_snapshot.h"
+#include "../tetris/tetris_controller.h"
+#include "../tetris/tetris_game_info_t_raii.h"
+
+namespace {
+
+// Distinct frames cycled through, so copies do not all hit one cache line
+constexpr int kFrames = 64;
+
+/**
+ * @brief A frame stored the way GameInfo_t used to be: every row of the
+ * field and of the next figure allocated on its own.
+ */
+class JaggedFrame {
+ public:
+  JaggedFrame() {
+    info_.field = new int *[kFieldHeight];
+    for (int i = 0; i < kFieldHeight; i++)
+      info_.field[i] = new int[kFieldWidth];
+    info_.next = new int *[kNextFieldHeight];
+    for (int i = 0; i < kNextFieldHeight; i++)
+      info_.next[i] = new int[kNextFieldWidth];
+  }
+  ~JaggedFrame() {
+    for (int i = 0; i < kFieldHeight; i++) delete[] info_.field[i];
+    delete[] info_.field;
+    for (int i = 0; i < kNextFieldHeight; i++) delete[] info_.next[i];
+    delete[] info_.next;
+  }
+  JaggedFrame(const JaggedFrame &) = delete;
+  JaggedFrame &operator=(const JaggedFrame &) = delete;
+
+  void CopyFrom(const GameInfo_t &info) {
+    for (int i = 0; i < kFieldHeight; i++)
+      for (int j = 0; j < kFieldWidth; j++)
+        info_.field[i][j] = info.field[i][j];
+    for (int i = 0; i < kNextFieldHeight; i++)
+      for (int j = 0; j < kNextFieldWidth; j++)
+        info_.next[i][j] = info.next[i][j];
+    info_.score = info.score;
+    info_.high_score = info.high_score;
+    info_.level = info.level;
+    info_.speed = info.speed;
+    info_.pause = info.pause;
+  }
+
+  const GameInfo_t &Info() const { return info_; }
+
+ private:
+  GameInfo_t info_ = {};
+};
+
+long SumCells(const GameInfo_t &info) {
+  long sum = 0;
+  for (int i = 0; i < kFieldHeight; i++)
+    for (int j = 0; j < kFieldWidth; j++) sum += info.field[i][j];
+  return sum;
+}
+
+long SumCells(const s21::GameSnapshot &snapshot) {
+  long sum = 0;
+  for (int i = 0; i < kFieldHeight; i++)
+    for (int j = 0; j < kFieldWidth; j++) sum += snapshot.field[i][j];
+  return sum;
+}
+
+template <class Step>
+double NanosPerCall(Step step, int rounds) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < rounds; ++i) step(i % kFrames);
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         rounds;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  int rounds = argc > 1 ? std::atoi(argv[1]) : 10000000;
+
+  // Frames of a real game, in both layouts
+  GameInfo game_info;
+  board_t board = {};
+  init_board_seeded(&board, 1, RANDOMIZER_BAG7);
+  game_stats_t stats;
+  init_transient_stats(&stats);
+  game_state state = START;
+  s21::ManualGameClock clock(std::chrono::milliseconds(s21::kTetrisTickInMs));
+  s21::TetrisController controller(game_info.get(), &state, &board, &stats,
+                                   &clock);
+  controller.processUserInput(UserAction_t::Start, false);
+  std::vector<std::unique_ptr<JaggedFrame>> jagged;
+  std::vector<s21::GameSnapshot> snapshots(kFrames);
+  s21::GameSnapshot current = {};
+  for (int frame = 0; frame < kFrames; ++frame) {
+    for (int tick = 0; tick < 100; ++tick) clock.Step();
+    controller.processUserInput(
+        frame % 3 == 0 ? UserAction_t::Left : UserAction_t::Down, false);
+    controller.UpdateCurrentState();
+    jagged.push_back(std::make_unique<JaggedFrame>());
+    jagged.back()->CopyFrom(controller.GetGameInfo());
+    s21::CaptureSnapshot(controller.GetGameInfo(), current);
+    s21::CopySnapshot(current, snapshots[frame]);
+  }
+
+  long checksum = 0;
+  JaggedFrame jagged_copy;
+  double jagged_copy_ns = NanosPerCall(
+      [&](int frame) {
+        jagged_copy.CopyFrom(jagged[frame]->Info());
+        checksum += jagged_copy.Info().field[frame % kFieldHeight][0];
+      },
+      rounds);
+  s21::GameSnapshot snapshot_copy = {};
+  double snapshot_copy_ns = NanosPerCall(
+      [&](int frame) {
+        s21::CopySnapshot(snapshots[frame], snapshot_copy);
+        checksum += snapshot_copy.field[frame % kFieldHeight][0];
+      },
+      rounds);
+  double jagged_read_ns = NanosPerCall(
+      [&](int frame) { checksum += SumCells(jagged[frame]->Info()); },
+      rounds);
+  double snapshot_read_ns = NanosPerCall(
+      [&](int frame) { checksum += SumCells(snapshots[frame]); }, rounds);
+
+  std::printf("snapshot size   %zu bytes\n", sizeof(s21::GameSnapshot));
+  std::printf("%-24s %12s %12s\n", "layout", "copy ns", "read ns");
+  std::printf("%-24s %12.1f %12.1f\n", "int** rows", jagged_copy_ns,
+              jagged_read_ns);
+  std::printf("%-24s %12.1f %12.1f\n", "flat snapshot", snapshot_copy_ns,
+              snapshot_read_ns);
+  std::printf("copy speedup    %.2fx (checksum %ld)\n",
+              jagged_copy_ns / snapshot_copy_ns, checksum);
+  return 0;
+}
@@ -0,0 +1,85 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "../snake/snake_autopilot.h"
+#include "../work_stealing_pool.h"
+
+namespace {
+
+/**
+ * @brief Wraps the autopilot and accumulates the time spent deciding.
+ */
+class TimedAutopilot : public s21::SnakePolicy {
+ public:
+  UserAction_t Decide(const s21::SnakeModel &model) override {
+    auto start = std::chrono::steady_clock::now();
+    UserAction_t action = policy_.Decide(model);
+    elapsed_ += std::chrono::steady_clock::now() - start;
+    ++decisions_;
+    return action;
+  }
+
+  long decisions() const { return decisions_; }
+  std::chrono::steady_clock::duration elapsed() const { return elapsed_; }
+
+ private:
+  s21::AutopilotPolicy policy_;
+  long decisions_ = 0;
+  std::chrono::steady_clock::duration elapsed_{};
+};
+
+struct GameResult {
+  bool win = false;
+  long decisions = 0;
+  double decide_seconds = 0;
+};
+
+GameResult PlayGame(uint32_t seed) {
+  s21::SnakeModel model("", nullptr, seed);
+  TimedAutopilot pilot;
+  model.SetPilot(&pilot);
+  model.FSM(UserAction_t::Start);
+  while (model.GetGameState() == s21::GameState::kRunning) {
+    model.Tick();
+  }
+  return {model.GetLevel() == kWin, pilot.decisions(),
+          std::chrono::duration<double>(pilot.elapsed()).count()};
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  int games = argc > 1 ? std::atoi(argv[1]) : 10000;
+  std::vector<GameResult> results(games);
+
+  auto start = std::chrono::steady_clock::now();
+  {
+    s21::WorkStealingPool pool;
+    for (int i = 0; i < games; ++i) {
+      pool.Submit([&results, i] { results[i] = PlayGame(i + 1); });
+    }
+  }
+  double wall_seconds = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+
+  int wins = 0;
+  long decisions = 0;
+  double decide_seconds = 0;
+  for (const auto &result : results) {
+    wins += result.win;
+    decisions += result.decisions;
+    decide_seconds += result.decide_seconds;
+  }
+
+  std::printf("field           %dx%d\n", kFieldWidth, kFieldHeight);
+  std::printf("games           %d\n", games);
+  std::printf("win rate        %.2f%%\n", 100.0 * wins / games);
+  std::printf("decisions       %ld\n", decisions);
+  std::printf("decisions/sec   %.0f (per core)\n", decisions / decide_seconds);
+  std::printf("wall time       %.3f s\n", wall_seconds);
+  return wins == games ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#include "../snake/snake_autopilot.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Wraps the autopilot and accumulates the time spent deciding, so it
+ * can be taken out of the measured model time.
+ */
+template <class Model>
+class TimedAutopilot
+    : public s21::BasicSnakePolicy<Model::kWidth, Model::kHeight> {
+ public:
+  UserAction_t Decide(const Model &model) override {
+    auto start = Clock::now();
+    UserAction_t action = policy_.Decide(model);
+    elapsed_ += Clock::now() - start;
+    return action;
+  }
+
+  Clock::duration elapsed() const { return elapsed_; }
+
+ private:
+  s21::BasicAutopilotPolicy<Model::kWidth, Model::kHeight> policy_;
+  Clock::duration elapsed_{};
+};
+
+/**
+ * @brief Plays seeded autopilot games on one board size and prints the model
+ * step and render throughput.
+ *
+ * Every game runs from the initial snake to game over, so the step rate
+ * covers all snake lengths. The render rate is measured on the final, full
+ * board, which is the most expensive frame to draw.
+ */
+template <class Model>
+void RunBoardSize(int games, int renders) {
+  long moves = 0;
+  int wins = 0;
+  Clock::duration model_time{};
+  Clock::duration render_time{};
+
+  for (int game = 0; game < games; ++game) {
+    s21::ManualGameClock game_clock{std::chrono::milliseconds(s21::kTickInMs)};
+    Model model("", &game_clock, game + 1);
+    auto pilot = std::make_unique<TimedAutopilot<Model>>();
+    model.SetPilot(pilot.get());
+    model.FSM(UserAction_t::Start);
+
+    auto start = Clock::now();
+    while (model.GetGameState() == s21::GameState::kRunning) {
+      moves += model.Tick();
+    }
+    model_time += Clock::now() - start - pilot->elapsed();
+    wins += model.GetLevel() == kWin;
+
+    start = Clock::now();
+    for (int i = 0; i < renders; ++i) {
+      model.UpdateCurrentState();
+    }
+    render_time += Clock::now() - start;
+  }
+
+  std::printf("%2dx%-5d %8d %9.1f%% %14.0f %14.1f\n", Model::kWidth,
+              Model::kHeight, games, 100.0 * wins / games,
+              moves / std::chrono::duration<double>(model_time).count(),
+              std::chrono::duration<double, std::nano>(render_time).count() /
+                  (static_cast<double>(games) * renders));
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  int games = argc > 1 ? std::atoi(argv[1]) : 20;
+  int renders = argc > 2 ? std::atoi(argv[2]) : 1000;
+  std::printf("%-8s %8s %10s %14s %14s\n", "field", "games", "win rate",
+              "moves/sec", "ns/render");
+  RunBoardSize<s21::SnakeModel>(games, renders);
+  RunBoardSize<s21::TallSnakeModel>(games, renders);
+  RunBoardSize<s21::SquareSnakeModel>(games, renders);
+  return 0;
+}
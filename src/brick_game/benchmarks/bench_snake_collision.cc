@@ -0,0 +1,90 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "../snake/snake_model.h"
+
+namespace s21 {
+
+/**
+ * @brief Measures SnakeModel tick throughput for a range of snake lengths.
+ *
+ * The snake follows a Hamiltonian cycle of the field, so it never collides,
+ * and the apple is parked on the cell right behind the tail, so the length
+ * stays fixed while the ticks are timed.
+ */
+class SnakeModelBenchmark {
+ public:
+  static std::vector<Cell> BuildCycle() {
+    std::vector<Cell> cycle;
+    cycle.reserve(kFieldCellCount);
+    for (int row = 0; row < kFieldHeight; ++row) {
+      for (int i = 1; i < kFieldWidth; ++i) {
+        int col = row % 2 == 0 ? i : kFieldWidth - i;
+        cycle.emplace_back(row, col);
+      }
+    }
+    for (int row = kFieldHeight - 1; row >= 0; --row) {
+      cycle.emplace_back(row, 0);
+    }
+    return cycle;
+  }
+
+  static SnakeDirection DirectionBetween(Cell from, Cell to) {
+    if (to.first < from.first) return SnakeDirection::kUp;
+    if (to.first > from.first) return SnakeDirection::kDown;
+    if (to.second < from.second) return SnakeDirection::kLeft;
+    return SnakeDirection::kRight;
+  }
+
+  static double TicksPerSecond(SnakeModel &model,
+                               const std::vector<Cell> &cycle, int length,
+                               long ticks) {
+    const int n = static_cast<int>(cycle.size());
+    int head = length - 1;
+    model.snake_.clear();
+    for (int i = head; i >= 0; --i) {
+      model.snake_.push_back(cycle[i]);
+    }
+    model.RebuildOccupancy();
+    model.direction_ = DirectionBetween(cycle[head - 1], cycle[head]);
+    model.apple_ = cycle[n - 1];
+    model.game_state_ = GameState::kRunning;
+
+    auto start = std::chrono::steady_clock::now();
+    for (long t = 0; t < ticks; ++t) {
+      int next = (head + 1) % n;
+      model.next_direction_ = DirectionBetween(cycle[head], cycle[next]);
+      model.apple_ = model.snake_.back();
+      model.MoveOneStepForward();
+      head = next;
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    if (model.game_state_ != GameState::kRunning ||
+        static_cast<int>(model.snake_.size()) != length) {
+      std::fprintf(stderr, "benchmark run diverged at length %d\n", length);
+      std::exit(1);
+    }
+    return ticks / std::chrono::duration<double>(stop - start).count();
+  }
+
+  static void Run(long ticks) {
+    SnakeModel model(".");
+    auto cycle = BuildCycle();
+    std::printf("%-8s %16s\n", "length", "ticks/sec");
+    for (int length : {4, 25, 50, 100, 150, 190}) {
+      std::printf("%-8d %16.0f\n", length,
+                  TicksPerSecond(model, cycle, length, ticks));
+    }
+  }
+};
+
+}  // namespace s21
+
+int main(int argc, char *argv[]) {
+  long ticks = argc > 1 ? std::atol(argv[1]) : 2000000;
+  s21::SnakeModelBenchmark::Run(ticks);
+  return 0;
+}
@@ -0,0 +1,66 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <random>
+
+#include "../tetris/fsm.h"
+#include "../tetris/tetris_backend.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Plays tetris games with random input on one board size and prints
+ * the state machine step throughput.
+ *
+ * Every game runs from the first spawn to game over. Inputs are drawn from a
+ * seeded generator and each game seeds its board, so every size gets the
+ * same input stream and piece sequences.
+ */
+template <class Board>
+void RunBoardSize(int games) {
+  static const signals kMoves[] = {ACTION_BTN, MOVE_LEFT, MOVE_RIGHT,
+                                   MOVE_DOWN, MOVE_DOWN};
+  std::mt19937 rng(1);
+  long steps = 0;
+  long pieces = 0;
+  Clock::duration time{};
+
+  for (int game = 0; game < games; ++game) {
+    Board board = {};
+    game_stats_t stats = {};
+    init_board_seeded(&board, game, RANDOMIZER_BAG7);
+    init_transient_stats(&stats);
+    game_state state = START;
+    sigact(START_BTN, &state, &stats, &board);
+
+    auto start = Clock::now();
+    while (state != GAMEOVER) {
+      signals sig = NOSIG;
+      if (state == MOVING) sig = kMoves[rng() % std::size(kMoves)];
+      if (state == SPAWN) ++pieces;
+      sigact(sig, &state, &stats, &board);
+      ++steps;
+    }
+    time += Clock::now() - start;
+  }
+
+  double seconds = std::chrono::duration<double>(time).count();
+  std::printf("%2dx%-5d %8d %12.1f %14.0f %14.0f\n", Board::kCols,
+              Board::kRows, games, static_cast<double>(pieces) / games,
+              steps / seconds, pieces / seconds);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  int games = argc > 1 ? std::atoi(argv[1]) : 1000;
+  std::printf("%-8s %8s %12s %14s %14s\n", "field", "games", "pieces/game",
+              "steps/sec", "pieces/sec");
+  RunBoardSize<board_t>(games);
+  RunBoardSize<tall_board_t>(games);
+  RunBoardSize<square_board_t>(games);
+  return 0;
+}
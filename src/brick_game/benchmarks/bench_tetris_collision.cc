@@ -0,0 +1,128 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "../tetris/tetris_backend.h"
+
+namespace {
+
+/**
+ * @brief The int sprites the figures were stored as before the row bitmask
+ * board, expanded from the piece table.
+ */
+int sprites[TETRAMINOS][4][4][4];
+
+void ExpandSprites() {
+  for (uint8_t piece = 0; piece < TETRAMINOS; ++piece) {
+    tetramino_t tetramino = {};
+    tetramino.piece = piece;
+    const figure_t *figure = tetramino_figure(&tetramino);
+    for (int rotation = 0; rotation < 4; ++rotation)
+      for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+          sprites[piece][rotation][i][j] =
+              (figure->row_mask[rotation][i] >> j) & 1;
+  }
+}
+
+/**
+ * @brief The cell-by-cell collision check the backend used before the row
+ * bitmask board, kept here as the reference path.
+ */
+bool SpriteCollide(const tetramino_t *tetramino, const board_t *board) {
+  const auto &sprite = sprites[tetramino->piece][tetramino->rotation];
+  bool rc = false;
+  for (int i = 0; i < 4; ++i)
+    for (int j = 0; j < 4; ++j) {
+      if (sprite[i][j] != 0 && tetramino->row_pos + i > BOARD_ROWS - 1)
+        rc = true;
+      if (sprite[i][j] != 0 &&
+          board->board[tetramino->row_pos + i][tetramino->col_pos + j] != 0)
+        rc = true;
+    }
+  return rc;
+}
+
+/**
+ * @brief Fills the bottom half of the board with random cells, keeping the
+ * color grid and the row masks in sync.
+ */
+void FillBoard(board_t *board, std::mt19937 &rng) {
+  init_board_seeded(board, 1, RANDOMIZER_UNIFORM);
+  for (int row = BOARD_ROWS / 2; row < BOARD_ROWS; ++row)
+    for (int col = 0; col < BOARD_COLS; ++col)
+      if (rng() % 2 == 0) {
+        board->board[row][col] = kColorRed;
+        board->rows[row] |= static_cast<uint16_t>(1u << col);
+      }
+}
+
+/**
+ * @brief Returns random placements whose cells all lie inside the board, the
+ * only positions where both paths are defined.
+ */
+std::vector<tetramino_t> MakeQueries(board_t *board, std::mt19937 &rng,
+                                     int count) {
+  std::vector<tetramino_t> queries;
+  queries.reserve(count);
+  while (static_cast<int>(queries.size()) < count) {
+    tetramino_t tetramino = gen_next_tetramino(board);
+    const figure_t *figure = tetramino_figure(&tetramino);
+    tetramino.rotation = rng() % (figure->max_rotation + 1);
+    tetramino.row_pos = rng() % BOARD_ROWS;
+    tetramino.col_pos = static_cast<int>(rng() % (BOARD_COLS + 3)) - 3;
+    bool inside = !check_lborder_collide(&tetramino) &&
+                  !check_rborder_collide(&tetramino);
+    for (int i = 0; i < 4; ++i)
+      if (figure->row_mask[tetramino.rotation][i] != 0 &&
+          tetramino.row_pos + i >= BOARD_ROWS)
+        inside = false;
+    if (inside) queries.push_back(tetramino);
+  }
+  return queries;
+}
+
+template <class Check>
+double NanosPerCheck(Check check, const std::vector<tetramino_t> &queries,
+                     const board_t &board, int rounds, long &hits) {
+  auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < rounds; ++round)
+    for (const tetramino_t &query : queries) hits += check(&query, &board);
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         (static_cast<double>(rounds) * queries.size());
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  int rounds = argc > 1 ? std::atoi(argv[1]) : 2000;
+  std::mt19937 rng(1);
+  ExpandSprites();
+  board_t board = {};
+  FillBoard(&board, rng);
+  std::vector<tetramino_t> queries = MakeQueries(&board, rng, 4096);
+
+  for (const tetramino_t &query : queries) {
+    if (SpriteCollide(&query, &board) != check_board_collide(&query, &board)) {
+      std::fprintf(stderr, "collision paths disagree\n");
+      return 1;
+    }
+  }
+
+  long sprite_hits = 0;
+  long mask_hits = 0;
+  double sprite_ns =
+      NanosPerCheck(SpriteCollide, queries, board, rounds, sprite_hits);
+  double mask_ns =
+      NanosPerCheck(check_board_collide<BOARD_ROWS, BOARD_COLS>, queries, board,
+                    rounds, mask_hits);
+
+  std::printf("%-16s %12s %12s\n", "path", "ns/check", "hits");
+  std::printf("%-16s %12.2f %12ld\n", "sprite cells", sprite_ns, sprite_hits);
+  std::printf("%-16s %12.2f %12ld\n", "row bitmask", mask_ns, mask_hits);
+  std::printf("speedup          %.2fx\n", sprite_ns / mask_ns);
+  return 0;
+}
@@ -0,0 +1,111 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../game_clock.h"
+#include "../tetris/tetris_controller.h"
+#include "../tetris/tetris_game_info_t_raii.h"
+
+namespace {
+
+// How many times the desktop view read the frame per timer tick: the timer
+// itself, the status line and the two canvases.
+constexpr int kReadsPerFrame = 4;
+
+/**
+ * @brief The bridge as it was before the typed handle: every field fetched
+ * with its own dynamic_cast of the global instance, and every read
+ * rendering the frame again.
+ */
+GameInfo_t LegacyUpdateCurrentState() {
+  GameInfo_t *game_info =
+      dynamic_cast<s21::TetrisController *>(s21::Controller::instance)
+          ->game_info;
+  [[maybe_unused]] const game_state *state =
+      dynamic_cast<s21::TetrisController *>(s21::Controller::instance)->state;
+  [[maybe_unused]] const game_stats_t *stats =
+      dynamic_cast<s21::TetrisController *>(s21::Controller::instance)->stats;
+  [[maybe_unused]] board_t *board =
+      dynamic_cast<s21::TetrisController *>(s21::Controller::instance)->board;
+  dynamic_cast<s21::TetrisController *>(s21::Controller::instance)
+      ->UpdateCurrentState();
+  return *game_info;
+}
+
+/**
+ * @brief Reads the frame through the old bridge's dynamic_cast without
+ * rendering it again.
+ */
+int LegacyLevel() {
+  return dynamic_cast<s21::TetrisController *>(s21::Controller::instance)
+      ->game_info->level;
+}
+
+template <class Frame>
+double NanosPerFrame(Frame frame, s21::ManualGameClock &clock, int frames,
+                     long &checksum) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < frames; ++i) {
+    clock.Step();
+    checksum += frame();
+  }
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         frames;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  int frames = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+  GameInfo game_info;
+  board_t board = {};
+  init_board_seeded(&board, 1, RANDOMIZER_BAG7);
+  game_stats_t stats;
+  init_transient_stats(&stats);
+  game_state state = START;
+  s21::ManualGameClock clock(std::chrono::milliseconds(s21::kTetrisTickInMs));
+  s21::TetrisController controller(game_info.get(), &state, &board, &stats,
+                                   &clock);
+  controller.processUserInput(UserAction_t::Start, false);
+
+  // Every path reads the frame kReadsPerFrame times. The old desktop view
+  // rendered on every read; the other two paths render once per frame, so
+  // the gap between them is the cost of the dynamic_cast lookups alone.
+  long checksum = 0;
+  double legacy_ns = NanosPerFrame(
+      [] {
+        int level = 0;
+        for (int i = 0; i < kReadsPerFrame; ++i)
+          level += LegacyUpdateCurrentState().level;
+        return level;
+      },
+      clock, frames, checksum);
+  double legacy_once_ns = NanosPerFrame(
+      [] {
+        int level = LegacyUpdateCurrentState().level;
+        for (int i = 1; i < kReadsPerFrame; ++i) level += LegacyLevel();
+        return level;
+      },
+      clock, frames, checksum);
+  double typed_ns = NanosPerFrame(
+      [&controller] {
+        controller.UpdateCurrentState();
+        int level = 0;
+        for (int i = 0; i < kReadsPerFrame; ++i)
+          level += controller.GetGameInfo().level;
+        return level;
+      },
+      clock, frames, checksum);
+
+  std::printf("%-24s %8s %12s\n", "frame path", "renders", "ns/frame");
+  std::printf("%-24s %8d %12.1f\n", "dynamic_cast bridge", kReadsPerFrame,
+              legacy_ns);
+  std::printf("%-24s %8d %12.1f\n", "dynamic_cast bridge", 1,
+              legacy_once_ns);
+  std::printf("%-24s %8d %12.1f\n", "typed handle", 1, typed_ns);
+  std::printf("speedup          %.2fx (checksum %ld)\n", legacy_ns / typed_ns,
+              checksum);
+  return 0;
+}
@@ -0,0 +1,134 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../tetris/fsm.h"
+#include "../tetris/tetris_backend.h"
+#include "../tetris/tetris_search.h"
+
+namespace {
+
+/**
+ * @brief Checks the cached column heights and holes against a scan of the
+ * row masks.
+ */
+template <class Board>
+bool ColumnsMatchRows(const Board &board) {
+  for (int col = 0; col < Board::kCols; ++col) {
+    int height = 0;
+    int holes = 0;
+    for (int row = 0; row < Board::kRows; ++row) {
+      bool filled = (board.rows[row] >> col) & 1u;
+      if (filled && height == 0) height = Board::kRows - row;
+      if (!filled && height != 0) ++holes;
+    }
+    if (board.heights[col] != height || board.holes[col] != holes)
+      return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Checks drop_distance() against moving the piece down row by row.
+ */
+template <class Board>
+bool DropDistanceMatches(const Board &board, const tetramino_t &tetramino) {
+  tetramino_t probe = tetramino;
+  int distance = 0;
+  for (probe.row_pos++; !check_board_collide(&probe, &board); probe.row_pos++)
+    ++distance;
+  return drop_distance(&board, &tetramino) == distance;
+}
+
+/**
+ * @brief Sends the planned moves through the game's own move handlers on a
+ * copy of the board and checks the piece locks exactly at @p target.
+ */
+template <class Board>
+bool PlanReachesTarget(const Board &board, const tetramino_t &target) {
+  signals moves[search_states<Board::kRows, Board::kCols>];
+  int count = plan_placement_moves(&board, &board.tetramino_curr, &target,
+                                   moves);
+  if (count < 0) return false;
+
+  Board copy = board;
+  game_state state = MOVING;
+  for (int i = 0; i < count && state == MOVING; ++i)
+    on_moving_state(moves[i], &state, &copy);
+  if (state != MOVING) return false;
+  on_moving_state(MOVE_DOWN, &state, &copy);
+
+  const tetramino_t &locked = copy.tetramino_curr;
+  return state == ATTACHING && locked.row_pos == target.row_pos &&
+         locked.col_pos == target.col_pos &&
+         locked.rotation == target.rotation;
+}
+
+/**
+ * @brief Plays one seeded game on @p Board with every check on: each planned
+ * move sequence must land its piece, and the column cache must match the
+ * rows after every piece.
+ */
+template <class Board>
+bool CheckedGamePasses() {
+  bool planned_ok = true;
+  bool columns_ok = true;
+  Board board = {};
+  init_board_seeded(&board, 0, RANDOMIZER_BAG7);
+  for (int piece = 0; piece < 500; ++piece) {
+    // The board as the piece spawns: spawning only deals the next piece
+    Board spawned = board;
+    spawned.tetramino_curr = spawned.tetramino_next;
+    placement_t best;
+    if (autoplay_piece(&board, weighted_heuristic, &default_heuristic_weights,
+                       &best) == 0)
+      break;
+    if (!PlanReachesTarget(spawned, best.tetramino)) planned_ok = false;
+    if (!DropDistanceMatches(spawned, spawned.tetramino_curr) ||
+        !DropDistanceMatches(spawned, best.tetramino) ||
+        !ColumnsMatchRows(board))
+      columns_ok = false;
+  }
+  if (!planned_ok)
+    std::fprintf(stderr, "%dx%d: planned moves miss their placement\n",
+                 Board::kCols, Board::kRows);
+  if (!columns_ok)
+    std::fprintf(stderr,
+                 "%dx%d: column heights or holes drifted from the rows\n",
+                 Board::kCols, Board::kRows);
+  return planned_ok && columns_ok;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  int games = argc > 1 ? std::atoi(argv[1]) : 10;
+  long max_pieces = argc > 2 ? std::atol(argv[2]) : 5000;
+
+  // One checked game on every board size first
+  if (!CheckedGamePasses<board_t>() || !CheckedGamePasses<tall_board_t>() ||
+      !CheckedGamePasses<square_board_t>())
+    return 1;
+
+  autoplay_result_t total = {};
+  auto start = std::chrono::steady_clock::now();
+  for (int game = 1; game <= games; ++game) {
+    board_t board;
+    autoplay_result_t result =
+        play_seeded_game(&board, game, max_pieces, weighted_heuristic,
+                         &default_heuristic_weights);
+    total.pieces += result.pieces;
+    total.lines += result.lines;
+    total.placements += result.placements;
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+  std::printf("games           %d\n", games);
+  std::printf("pieces          %ld\n", total.pieces);
+  std::printf("lines           %ld\n", total.lines);
+  std::printf("pieces/sec      %.0f\n", total.pieces / seconds);
+  std::printf("placements/sec  %.0f\n", total.placements / seconds);
+  return 0;
+}
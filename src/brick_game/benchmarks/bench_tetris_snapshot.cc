@@ -0,0 +1,93 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "../tetris/tetris_backend.h"
+#include "../tetris/tetris_search.h"
+#include "../tetris/tetris_snapshot.h"
+
+namespace {
+
+struct Game {
+  board_t board = {};
+  game_stats_t stats = {};
+  game_state state = MOVING;
+};
+
+/**
+ * @brief Spawns the next piece and locks it at the best placement, the way
+ * the tuner plays. Returns false once the stack tops out.
+ */
+bool PlayPiece(Game &game) {
+  board_t &board = game.board;
+  board.tetramino_curr = board.tetramino_next;
+  board.tetramino_next = gen_next_tetramino(&board);
+  placement_t best;
+  if (check_board_collide(&board.tetramino_curr, &board) ||
+      find_best_placement(&board, &board.tetramino_curr, weighted_heuristic,
+                          &default_heuristic_weights, &best) == 0)
+    return false;
+  board.tetramino_curr = best.tetramino;
+  attach_tetramino(&board);
+  board.cleared_rows = clear_full_rows(&board, best.tetramino.row_pos);
+  game.stats.score += __builtin_popcount(board.cleared_rows);
+  return true;
+}
+
+tetris_snapshot_t Save(const Game &game) {
+  tetris_snapshot_t snapshot;
+  std::memset(&snapshot, 0, sizeof(snapshot));  // Padding takes part in memcmp
+  save_snapshot(&game.board, &game.stats, game.state, &snapshot);
+  return snapshot;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  int pieces = argc > 1 ? std::atoi(argv[1]) : 2000;
+  int rounds = argc > 2 ? std::atoi(argv[2]) : 1000;
+
+  // Record an undo stack with a snapshot before every piece
+  Game game;
+  init_board_seeded(&game.board, 1, RANDOMIZER_BAG7);
+  std::vector<tetris_snapshot_t> undo;
+  while (static_cast<int>(undo.size()) < pieces) {
+    undo.push_back(Save(game));
+    if (!PlayPiece(game)) break;
+  }
+  tetris_snapshot_t end = Save(game);
+
+  // Undo to the middle and play on: the game must end in the same state
+  restore_snapshot(&undo[undo.size() / 2], nullptr, &game.board, &game.stats,
+                   &game.state);
+  for (std::size_t i = undo.size() / 2; i < undo.size(); ++i)
+    PlayPiece(game);
+  tetris_snapshot_t replayed = Save(game);
+  if (std::memcmp(&end, &replayed, sizeof(end)) != 0) {
+    std::fprintf(stderr, "restored game diverged\n");
+    return 1;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  unsigned checksum = 0;
+  for (int round = 0; round < rounds; ++round) {
+    for (const tetris_snapshot_t &snapshot : undo) {
+      restore_snapshot(&snapshot, nullptr, &game.board, &game.stats,
+                       &game.state);
+      checksum += Save(game).rows[BOARD_ROWS - 1];
+    }
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  double pairs = static_cast<double>(rounds) * undo.size();
+
+  std::printf("snapshot size   %zu bytes\n", sizeof(tetris_snapshot_t));
+  std::printf("undo depth      %zu\n", undo.size());
+  std::printf("restore+save/s  %.0f\n", pairs / seconds);
+  std::printf("ns per pair     %.1f (checksum %u)\n", seconds * 1e9 / pairs,
+              checksum);
+  return 0;
+}
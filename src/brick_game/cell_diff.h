@@ -0,0 +1,56 @@
+#ifndef CELL_DIFF_H
+#define CELL_DIFF_H
+
+#include <array>
+#include <cstdint>
+
+#include "common.h"
+
+namespace s21 {
+
+/**
+ * @brief One field cell that took a new color.
+ */
+struct CellChange {
+  uint8_t row;
+  uint8_t col;
+  uint8_t color;
+};
+
+/**
+ * @brief The field cells one render changed, compared to the render before.
+ *
+ * Models fill it from the cells their moves, attaches and line clears marked,
+ * so a view or a spectator can repaint only those cells. Every cell appears
+ * at most once, which bounds the list by the field size.
+ *
+ * @tparam Cells The number of cells of the field.
+ */
+template <int Cells>
+struct BasicCellDiff {
+  int count = 0;
+  bool next_changed = false;  ///< The next figure preview was rewritten
+  std::array<CellChange, Cells> cells{};
+
+  void Clear() noexcept {
+    count = 0;
+    next_changed = false;
+  }
+
+  void Add(int row, int col, int color) noexcept {
+    cells[count++] = {static_cast<uint8_t>(row), static_cast<uint8_t>(col),
+                      static_cast<uint8_t>(color)};
+  }
+
+  const CellChange *begin() const noexcept { return cells.data(); }
+  const CellChange *end() const noexcept { return cells.data() + count; }
+};
+
+/**
+ * @brief The diff of the standard field shown by the views.
+ */
+using CellDiff = BasicCellDiff<kFieldHeight * kFieldWidth>;
+
+}  // namespace s21
+
+#endif  // CELL_DIFF_H
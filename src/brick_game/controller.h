@@ -1,6 +1,7 @@
 #ifndef CONTROLLER_H
 #define CONTROLLER_H
 
+#include "cell_diff.h"
 #include "common.h"
 
 namespace s21 {
@@ -50,6 +51,23 @@ class Controller {
    * @param hold Whether the action is being held down.
    */
   virtual void processUserInput(UserAction_t action, bool hold) = 0;
+  /**
+   * @brief Returns the game state rendered by the last update.
+   *
+   * Views read the frame through this method on the controller they were
+   * given, instead of through the global `updateCurrentState()` bridge.
+   *
+   * @return The rendered game state, owned by the controller.
+   */
+  virtual const GameInfo_t &GetGameInfo() const = 0;
+  /**
+   * @brief Returns the field cells the last update changed.
+   *
+   * Applying the changes to the frame before the last update yields
+   * `GetGameInfo()`, so a view that keeps its own copy of the field only
+   * touches these cells.
+   */
+  virtual const CellDiff &GetCellDiff() const = 0;
 };
 }  // namespace s21
 
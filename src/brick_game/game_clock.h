@@ -0,0 +1,125 @@
+#ifndef GAME_CLOCK_H
+#define GAME_CLOCK_H
+
+#include <chrono>
+
+namespace s21 {
+
+/**
+ * @brief Abstract time source used by the game loops.
+ *
+ * Models never read the system clock directly; they ask a `GameClock` and turn
+ * its readings into fixed-length simulation ticks with `FixedTimestep`. This
+ * keeps the simulation independent of wall-clock adjustments and lets
+ * headless runs drive the games with a manual clock.
+ */
+class GameClock {
+ public:
+  using Duration = std::chrono::steady_clock::duration;
+  using TimePoint = std::chrono::steady_clock::time_point;
+
+  virtual ~GameClock() = default;
+
+  /**
+   * @brief Returns the current time of this clock.
+   */
+  virtual TimePoint Now() const = 0;
+};
+
+/**
+ * @brief Real-time clock backed by `std::chrono::steady_clock`.
+ *
+ * The steady clock is monotonic, so system time changes never make the game
+ * stall or jump.
+ */
+class SteadyGameClock : public GameClock {
+ public:
+  TimePoint Now() const override { return std::chrono::steady_clock::now(); }
+};
+
+/**
+ * @brief Clock that only moves when told to.
+ *
+ * Used for headless and deterministic runs: each `Step()` advances the time by
+ * a whole number of ticks, so the game logic runs as fast as the CPU allows
+ * and always sees the same sequence of ticks.
+ */
+class ManualGameClock : public GameClock {
+ public:
+  /**
+   * @brief Constructs a manual clock stopped at time zero.
+   * @param tick The duration of one tick advanced by `Step()`.
+   */
+  explicit ManualGameClock(Duration tick) : tick_(tick) {}
+
+  TimePoint Now() const override { return now_; }
+
+  /**
+   * @brief Advances the clock by the given number of ticks.
+   */
+  void Step(int ticks = 1) { now_ += tick_ * ticks; }
+
+  /**
+   * @brief Advances the clock by an arbitrary duration.
+   */
+  void Advance(Duration duration) { now_ += duration; }
+
+ private:
+  Duration tick_;
+  TimePoint now_{};
+};
+
+/**
+ * @brief Returns the process-wide real-time clock used when a model is not
+ * given a clock of its own.
+ */
+inline GameClock *DefaultGameClock() {
+  static SteadyGameClock clock;
+  return &clock;
+}
+
+/**
+ * @brief Converts readings of a `GameClock` into fixed-length ticks.
+ *
+ * Every call to `Consume()` reports how many whole ticks have elapsed since
+ * the previous call and keeps the remainder for later, so the simulation
+ * advances in identical steps no matter how often the caller polls. A backlog
+ * longer than `max_catch_up_ticks` (e.g. after the process was suspended) is
+ * dropped instead of being replayed in one burst.
+ */
+class FixedTimestep {
+ public:
+  FixedTimestep(GameClock *clock, GameClock::Duration tick,
+                int max_catch_up_ticks)
+      : clock_(clock),
+        tick_(tick),
+        max_catch_up_ticks_(max_catch_up_ticks),
+        last_(clock->Now()) {}
+
+  /**
+   * @brief Returns the number of ticks due since the previous call.
+   */
+  int Consume() {
+    GameClock::TimePoint now = clock_->Now();
+    if (now <= last_) {
+      return 0;
+    }
+    auto ticks = (now - last_) / tick_;
+    if (ticks > max_catch_up_ticks_) {
+      last_ = now;
+      return max_catch_up_ticks_;
+    }
+    last_ += tick_ * ticks;
+    return static_cast<int>(ticks);
+  }
+
+ private:
+  GameClock *clock_;
+  GameClock::Duration tick_;
+  int max_catch_up_ticks_;
+  GameClock::TimePoint last_;
+};
+
+}  // namespace s21
+
+#endif  // GAME_CLOCK_H
@@ -0,0 +1,66 @@
+#include "game_loop.h"
+
+#include <algorithm>
+
+namespace s21 {
+
+GameLoop::GameLoop(Controller *controller, std::chrono::milliseconds tick)
+    : controller_(controller), tick_(tick) {
+  // Readers get a real frame even before the first tick. The controller may
+  // have rendered before, so its first diff is not against an empty field.
+  controller_->UpdateCurrentState();
+  PublishFrame(true);
+  thread_ = std::thread(&GameLoop::Run, this);
+}
+
+GameLoop::~GameLoop() {
+  running_ = false;
+  thread_.join();
+}
+
+bool GameLoop::PushInput(UserAction_t action, bool hold) {
+  InputEvent event = {.action = action,
+                      .hold = hold,
+                      .time = std::chrono::steady_clock::now()};
+  return input_.TryPush(event);
+}
+
+void GameLoop::Run() {
+  auto next_tick = std::chrono::steady_clock::now();
+  while (running_.load(std::memory_order_relaxed)) {
+    Step();
+    // A late tick does not make the following ones catch up; the models
+    // already replay the game time they missed
+    next_tick =
+        std::max(next_tick + tick_, std::chrono::steady_clock::now());
+    std::this_thread::sleep_until(next_tick);
+  }
+}
+
+void GameLoop::Step() {
+  InputEvent event;
+  while (input_.TryPop(event)) {
+    controller_->processUserInput(event.action, event.hold);
+  }
+  controller_->UpdateCurrentState();
+  PublishFrame(false);
+}
+
+void GameLoop::PublishFrame(bool full) {
+  if (full) {
+    CaptureSnapshot(controller_->GetGameInfo(), current_);
+  } else {
+    CaptureSnapshot(controller_->GetGameInfo(), controller_->GetCellDiff(),
+                    current_);
+  }
+  // If the reader never took the last frame, the next one it takes must also
+  // mark the rows that frame changed
+  uint32_t unread_rows = frames_.Pending() ? published_rows_ : 0;
+  GameSnapshot &frame = frames_.Back();
+  CopySnapshot(current_, frame);
+  frame.dirty_rows |= unread_rows;
+  published_rows_ = frame.dirty_rows;
+  frames_.Publish();
+}
+
+}  // namespace s21
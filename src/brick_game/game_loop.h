@@ -0,0 +1,83 @@
+#ifndef GAME_LOOP_H
+#define GAME_LOOP_H
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "common.h"
+#include "controller.h"
+#include "game_snapshot.h"
+#include "input_queue.h"
+#include "triple_buffer.h"
+
+namespace s21 {
+
+/**
+ * @brief The default time between two game logic updates.
+ */
+constexpr std::chrono::milliseconds kSimulationTick{5};
+
+/**
+ * @brief Runs a controller on its own simulation thread at a fixed rate.
+ *
+ * Every tick the thread applies the queued key presses, updates the game,
+ * applies the cells the controller reports changed to a `GameSnapshot` and
+ * publishes it through a triple buffer.
+ * Views push input and read frames without locks and never call the
+ * controller themselves, so a slow repaint cannot hold back gravity.
+ *
+ * `PushInput()` must be called from a single thread, and so must `Frame()`.
+ */
+class GameLoop {
+ public:
+  /**
+   * @brief Publishes the current state and starts the simulation thread.
+   * @param controller The game to run; it must outlive the loop.
+   * @param tick The time between two updates.
+   */
+  explicit GameLoop(Controller *controller,
+                    std::chrono::milliseconds tick = kSimulationTick);
+
+  /**
+   * @brief Stops and joins the simulation thread.
+   */
+  ~GameLoop();
+
+  GameLoop(const GameLoop &) = delete;
+  GameLoop &operator=(const GameLoop &) = delete;
+
+  /**
+   * @brief Queues a key press for the next tick.
+   * @return false if the queue is full and the key was dropped.
+   */
+  bool PushInput(UserAction_t action, bool hold);
+
+  /**
+   * @brief Returns the newest published game state.
+   *
+   * The state stays valid and unchanged until the next call. Frames published
+   * between two calls are skipped, but their changes are carried over:
+   * `dirty_rows` marks every row that changed since the frame returned by the
+   * previous call.
+   */
+  const GameSnapshot &Frame() { return frames_.Front(); }
+
+ private:
+  void Run();
+  void Step();
+  void PublishFrame(bool full);
+
+  Controller *controller_;
+  std::chrono::milliseconds tick_;
+  InputQueue input_;
+  GameSnapshot current_{};  ///< The newest frame, simulation thread only
+  uint32_t published_rows_ = 0;  ///< `dirty_rows` of the last published frame
+  TripleBuffer<GameSnapshot> frames_;
+  std::atomic<bool> running_{true};
+  std::thread thread_;
+};
+
+}  // namespace s21
+
+#endif  // GAME_LOOP_H
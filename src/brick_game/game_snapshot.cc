@@ -0,0 +1,96 @@
+#include "game_snapshot.h"
+
+namespace s21 {
+
+namespace {
+
+void CaptureNext(const GameInfo_t &info, GameSnapshot &snapshot) {
+  snapshot.has_next = info.next != nullptr;
+  for (int row = 0; row < kNextFieldHeight; ++row) {
+    for (int col = 0; col < kNextFieldWidth; ++col) {
+      snapshot.next[row][col] =
+          info.next != nullptr ? static_cast<uint8_t>(info.next[row][col]) : 0;
+    }
+  }
+}
+
+void CaptureStats(const GameInfo_t &info, uint32_t dirty_rows,
+                  GameSnapshot &snapshot) {
+  snapshot.sequence++;
+  snapshot.dirty_rows = dirty_rows;
+  snapshot.score = info.score;
+  snapshot.high_score = info.high_score;
+  snapshot.level = info.level;
+  snapshot.speed = info.speed;
+  snapshot.pause = info.pause != 0;
+}
+
+}  // namespace
+
+void CaptureSnapshot(const GameInfo_t &info, GameSnapshot &snapshot) {
+  uint32_t dirty_rows = 0;
+  for (int row = 0; row < kFieldHeight; ++row) {
+    uint8_t *cells = snapshot.field[row];
+    bool changed = false;
+    for (int col = 0; col < kFieldWidth; ++col) {
+      auto color = static_cast<uint8_t>(info.field[row][col]);
+      changed |= cells[col] != color;
+      cells[col] = color;
+    }
+    if (changed) {
+      dirty_rows |= uint32_t{1} << row;
+    }
+  }
+  CaptureNext(info, snapshot);
+  CaptureStats(info, dirty_rows, snapshot);
+}
+
+void CaptureSnapshot(const GameInfo_t &info, const CellDiff &diff,
+                     GameSnapshot &snapshot) {
+  uint32_t dirty_rows = 0;
+  for (const CellChange &change : diff) {
+    snapshot.field[change.row][change.col] = change.color;
+    dirty_rows |= uint32_t{1} << change.row;
+  }
+  if (diff.next_changed || snapshot.has_next != (info.next != nullptr)) {
+    CaptureNext(info, snapshot);
+  }
+  CaptureStats(info, dirty_rows, snapshot);
+}
+
+LegacyGameInfo::LegacyGameInfo() {
+  for (int row = 0; row < kFieldHeight; ++row) {
+    field_rows_[row] = &field_[row * kFieldWidth];
+  }
+  for (int row = 0; row < kNextFieldHeight; ++row) {
+    next_rows_[row] = &next_[row * kNextFieldWidth];
+  }
+  info_.field = field_rows_;
+}
+
+const GameInfo_t &LegacyGameInfo::Update(const GameSnapshot &snapshot) {
+  uint32_t dirty_rows = valid_ && snapshot.sequence == sequence_ + 1
+                            ? snapshot.dirty_rows
+                            : kAllRowsDirty;
+  for (int row = 0; row < kFieldHeight; ++row) {
+    if (dirty_rows & (uint32_t{1} << row)) {
+      for (int col = 0; col < kFieldWidth; ++col) {
+        field_rows_[row][col] = snapshot.field[row][col];
+      }
+    }
+  }
+  for (int i = 0; i < kNextFieldHeight * kNextFieldWidth; ++i) {
+    next_[i] = snapshot.next[i / kNextFieldWidth][i % kNextFieldWidth];
+  }
+  info_.next = snapshot.has_next ? next_rows_ : nullptr;
+  info_.score = snapshot.score;
+  info_.high_score = snapshot.high_score;
+  info_.level = snapshot.level;
+  info_.speed = snapshot.speed;
+  info_.pause = snapshot.pause;
+  sequence_ = snapshot.sequence;
+  valid_ = true;
+  return info_;
+}
+
+}  // namespace s21
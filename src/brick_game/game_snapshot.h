@@ -0,0 +1,101 @@
+#ifndef GAME_SNAPSHOT_H
+#define GAME_SNAPSHOT_H
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "cell_diff.h"
+#include "common.h"
+
+namespace s21 {
+
+/**
+ * @brief One rendered frame of a game in a single flat block.
+ *
+ * Cells are colors stored as bytes, row after row, so a reader indexes the
+ * field directly instead of chasing a pointer per row, and a whole frame is
+ * copied with one `memcpy` (see CopySnapshot()).
+ *
+ * Frames are numbered by `sequence`. `dirty_rows` has bit `r` set when field
+ * row `r` may differ from the frame the reader took before. A captured
+ * snapshot marks the rows changed since its previous capture, and
+ * GameLoop::Frame() adds the rows of any frames the reader skipped, so the
+ * mask covers everything changed since the reader's last read. A reader
+ * without an earlier frame must treat every row as dirty.
+ */
+struct GameSnapshot {
+  uint64_t sequence;
+  uint32_t dirty_rows;
+  int32_t score;
+  int32_t high_score;
+  int32_t level;
+  int32_t speed;
+  uint8_t pause;
+  uint8_t has_next;  ///< 0 for games without a next figure, as the snake
+  uint8_t field[kFieldHeight][kFieldWidth];
+  uint8_t next[kNextFieldHeight][kNextFieldWidth];
+};
+
+static_assert(std::is_trivially_copyable_v<GameSnapshot>,
+              "snapshots are copied with memcpy");
+static_assert(kFieldHeight <= 32, "dirty_rows has one bit per field row");
+
+/**
+ * @brief A mask with the bits of all field rows set.
+ */
+constexpr uint32_t kAllRowsDirty =
+    static_cast<uint32_t>((uint64_t{1} << kFieldHeight) - 1);
+
+inline void CopySnapshot(const GameSnapshot &from, GameSnapshot &to) {
+  std::memcpy(&to, &from, sizeof(GameSnapshot));
+}
+
+/**
+ * @brief Turns @p snapshot into the next frame, holding the state of @p info.
+ *
+ * The sequence number is advanced and `dirty_rows` marks the field rows that
+ * changed from the frame @p snapshot held before.
+ */
+void CaptureSnapshot(const GameInfo_t &info, GameSnapshot &snapshot);
+
+/**
+ * @brief Like CaptureSnapshot(), but touches only the cells in @p diff.
+ *
+ * @p snapshot must hold the frame @p diff was taken against, i.e. the
+ * previous render of the same game.
+ */
+void CaptureSnapshot(const GameInfo_t &info, const CellDiff &diff,
+                     GameSnapshot &snapshot);
+
+/**
+ * @brief Presents snapshots as a legacy `GameInfo_t` with `int**` rows, for
+ * code written against the jagged layout.
+ *
+ * The rows point into the adapter's own contiguous storage. Updating from the
+ * frame right after the previous one rewrites only its dirty rows.
+ */
+class LegacyGameInfo {
+ public:
+  LegacyGameInfo();
+  LegacyGameInfo(const LegacyGameInfo &) = delete;
+  LegacyGameInfo &operator=(const LegacyGameInfo &) = delete;
+
+  /**
+   * @brief Converts @p snapshot; the result stays valid until the next call.
+   */
+  const GameInfo_t &Update(const GameSnapshot &snapshot);
+
+ private:
+  int field_[kFieldHeight * kFieldWidth] = {};
+  int next_[kNextFieldHeight * kNextFieldWidth] = {};
+  int *field_rows_[kFieldHeight] = {};
+  int *next_rows_[kNextFieldHeight] = {};
+  GameInfo_t info_ = {};
+  uint64_t sequence_ = 0;
+  bool valid_ = false;
+};
+
+}  // namespace s21
+
+#endif  // GAME_SNAPSHOT_H
@@ -0,0 +1,78 @@
+#include "high_score_writer.h"
+
+#include <fstream>
+#include <iostream>
+
+namespace s21 {
+
+HighScoreWriter::HighScoreWriter(std::filesystem::path path,
+                                 std::chrono::milliseconds flush_interval)
+    : path_(std::move(path)),
+      flush_interval_(flush_interval),
+      thread_(&HighScoreWriter::Run, this) {}
+
+HighScoreWriter::~HighScoreWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_up_.notify_one();
+  thread_.join();
+}
+
+void HighScoreWriter::Submit(int high_score) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  pending_score_ = high_score;
+  dirty_ = true;
+}
+
+void HighScoreWriter::Flush() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    flush_requested_ = true;
+  }
+  wake_up_.notify_one();
+}
+
+void HighScoreWriter::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    wake_up_.wait_for(lock, flush_interval_,
+                      [this] { return stop_ || flush_requested_; });
+    flush_requested_ = false;
+    if (dirty_) {
+      int high_score = pending_score_;
+      dirty_ = false;
+      lock.unlock();
+      WriteFile(high_score);
+      lock.lock();
+    }
+    if (stop_ && !dirty_) {
+      return;
+    }
+  }
+}
+
+void HighScoreWriter::WriteFile(int high_score) const {
+  std::filesystem::path tmp_path = path_;
+  tmp_path += ".tmp";
+  {
+    std::ofstream fs(tmp_path, std::ios::trunc);
+    if (!fs.is_open() || !(fs << high_score << '\n') || !fs.flush()) {
+      // LCOV_EXCL_START
+      std::cerr << "Error: Unable to write " << tmp_path << std::endl;
+      return;
+      // LCOV_EXCL_STOP
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(tmp_path, path_, error);
+  if (error) {
+    // LCOV_EXCL_START
+    std::cerr << "Error: Unable to replace " << path_ << ": "
+              << error.message() << std::endl;
+    // LCOV_EXCL_STOP
+  }
+}
+
+}  // namespace s21
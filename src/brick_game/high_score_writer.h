@@ -0,0 +1,73 @@
+#ifndef HIGH_SCORE_WRITER_H
+#define HIGH_SCORE_WRITER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+namespace s21 {
+
+/**
+ * @brief The default time between two flushes of a `HighScoreWriter`.
+ */
+constexpr std::chrono::milliseconds kHighScoreFlushInterval{1000};
+
+/**
+ * @brief Persists a high score from a background thread.
+ *
+ * The game thread only hands over the latest value with `Submit()`, which
+ * never touches the filesystem. The writer thread coalesces all values
+ * submitted since its last write and stores the newest one once per flush
+ * interval, on `Flush()` (e.g. at game over) and on destruction. The file is
+ * written to a temporary sibling first and then renamed over the target, so
+ * it always holds a complete value.
+ */
+class HighScoreWriter {
+ public:
+  /**
+   * @brief Starts the writer thread.
+   * @param path The file the high score is stored in.
+   * @param flush_interval The time between two periodic flushes.
+   */
+  explicit HighScoreWriter(
+      std::filesystem::path path,
+      std::chrono::milliseconds flush_interval = kHighScoreFlushInterval);
+
+  /**
+   * @brief Writes the last submitted score, if any, and stops the thread.
+   */
+  ~HighScoreWriter();
+
+  HighScoreWriter(const HighScoreWriter &) = delete;
+  HighScoreWriter &operator=(const HighScoreWriter &) = delete;
+
+  /**
+   * @brief Hands a new high score to the writer without blocking on I/O.
+   */
+  void Submit(int high_score);
+
+  /**
+   * @brief Asks the writer thread to store the pending score now.
+   */
+  void Flush();
+
+ private:
+  void Run();
+  void WriteFile(int high_score) const;
+
+  std::filesystem::path path_;
+  std::chrono::milliseconds flush_interval_;
+  std::mutex mutex_;
+  std::condition_variable wake_up_;
+  int pending_score_ = 0;
+  bool dirty_ = false;
+  bool flush_requested_ = false;
+  bool stop_ = false;
+  std::thread thread_;
+};
+
+}  // namespace s21
+
+#endif  // HIGH_SCORE_WRITER_H
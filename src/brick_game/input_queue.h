@@ -0,0 +1,97 @@
+#ifndef INPUT_QUEUE_H
+#define INPUT_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+#include "common.h"
+
+namespace s21 {
+
+/**
+ * @brief Bounded wait-free queue for exactly one producer and one consumer
+ * thread.
+ *
+ * The slots form a ring indexed by two free-running counters: the producer
+ * only writes @c tail_ and the consumer only writes @c head_, so both sides
+ * finish in a fixed number of steps without locks or retries. Each side also
+ * keeps a cached copy of the other's counter and reloads it only when the
+ * ring looks full or empty, which keeps the shared cache lines quiet.
+ *
+ * @tparam T A trivially copyable element type.
+ * @tparam Capacity The number of slots, a power of two.
+ */
+template <class T, std::size_t Capacity>
+class SpscQueue {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "capacity must be a power of two");
+
+ public:
+  /**
+   * @brief Appends @p value. Call only from the producer thread.
+   * @return false if the queue is full and @p value was not added.
+   */
+  bool TryPush(const T &value) {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_cache_ == Capacity) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (tail - head_cache_ == Capacity) return false;
+    }
+    slots_[tail & kMask] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Takes the oldest value. Call only from the consumer thread.
+   * @return false if the queue is empty.
+   */
+  bool TryPop(T &value) {
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_cache_) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head == tail_cache_) return false;
+    }
+    value = slots_[head & kMask];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  static constexpr std::size_t Size() { return Capacity; }
+
+ private:
+  static constexpr std::size_t kMask = Capacity - 1;
+  static constexpr std::size_t kCacheLine = 64;
+
+  // Consumer side
+  alignas(kCacheLine) std::atomic<std::size_t> head_{0};
+  std::size_t tail_cache_ = 0;
+  // Producer side
+  alignas(kCacheLine) std::atomic<std::size_t> tail_{0};
+  std::size_t head_cache_ = 0;
+  alignas(kCacheLine) std::array<T, Capacity> slots_{};
+};
+
+/**
+ * @brief One key press, stamped when the input thread read it.
+ */
+struct InputEvent {
+  UserAction_t action = UserAction_t::Start;
+  bool hold = false;
+  std::chrono::steady_clock::time_point time;
+};
+
+// Far more key presses than a player can make between two game loop ticks
+constexpr std::size_t kInputQueueCapacity = 256;
+
+/**
+ * @brief Carries key presses from the thread that reads the keyboard to the
+ * game loop, which drains it once per tick.
+ */
+using InputQueue = SpscQueue<InputEvent, kInputQueueCapacity>;
+
+}  // namespace s21
+
+#endif  // INPUT_QUEUE_H
@@ -0,0 +1,196 @@
+#include "snake_autopilot.h"
+
+namespace s21 {
+
+namespace {
+
+// Cells kept between the head and the tail along the cycle after a shortcut,
+// so apples eaten on the way cannot make the head catch up with the tail.
+constexpr int kTailBuffer = 4;
+
+constexpr SnakeDirection kDirections[] = {
+    SnakeDirection::kUp, SnakeDirection::kDown, SnakeDirection::kLeft,
+    SnakeDirection::kRight};
+
+}  // namespace
+
+template <int Width, int Height>
+BasicAutopilotPolicy<Width, Height>::BasicAutopilotPolicy() {
+  // Columns are walked alternately down and up below row 0, which is the
+  // way back: (1,0) -> (19,0) -> (19,1) -> (1,1) -> ... -> (1,9) -> (0,9) ->
+  // (0,0) on the standard field. Odd columns go up, so there the initial
+  // snake already lies on the cycle.
+  std::array<Cell, Model::kCellCount> order;
+  int n = 0;
+  for (int col = 0; col < Width; ++col) {
+    for (int i = 1; i < Height; ++i) {
+      int row = col % 2 == 0 ? i : Height - i;
+      order[n++] = Cell(row, col);
+    }
+  }
+  for (int col = Width - 1; col >= 0; --col) {
+    order[n++] = Cell(0, col);
+  }
+
+  for (int i = 0; i < Model::kCellCount; ++i) {
+    Cell cell = order[i];
+    Cell next = order[(i + 1) % Model::kCellCount];
+    cycle_index_[Model::CellIndex(cell)] = i;
+    for (SnakeDirection direction : kDirections) {
+      if (NeighbourCell(cell, direction) == next) {
+        cycle_direction_[Model::CellIndex(cell)] = direction;
+      }
+    }
+  }
+
+  for (int row = 0; row < Height; ++row) {
+    left_column_.set(Model::CellIndex(Cell(row, 0)));
+    right_column_.set(Model::CellIndex(Cell(row, Width - 1)));
+  }
+}
+
+template <int Width, int Height>
+typename BasicAutopilotPolicy<Width, Height>::Board
+BasicAutopilotPolicy<Width, Height>::Expand(const Board &cells) const noexcept {
+  return cells | (cells << Width) | (cells >> Width) |
+         ((cells & ~right_column_) << 1) | ((cells & ~left_column_) >> 1);
+}
+
+template <int Width, int Height>
+int BasicAutopilotPolicy<Width, Height>::CycleDistance(
+    Cell from, Cell to) const noexcept {
+  int distance = cycle_index_[Model::CellIndex(to)] -
+                 cycle_index_[Model::CellIndex(from)];
+  return distance < 0 ? distance + Model::kCellCount : distance;
+}
+
+template <int Width, int Height>
+bool BasicAutopilotPolicy<Width, Height>::FindPathStep(const Model &model,
+                                                       Cell &step) noexcept {
+  const Board free_cells = ~model.GetOccupancy();
+  const int apple = Model::CellIndex(model.GetApple());
+
+  Board visited;
+  visited.set(Model::CellIndex(model.GetHead()));
+  layers_[0] = visited;
+  int depth = 0;
+  while (!layers_[depth].test(apple)) {
+    Board next = Expand(layers_[depth]) & free_cells & ~visited;
+    if (next.none()) {
+      return false;
+    }
+    visited |= next;
+    layers_[++depth] = next;
+  }
+
+  // Walk back from the apple through the BFS layers to the first step
+  Cell cell = model.GetApple();
+  for (int layer = depth - 1; layer > 0; --layer) {
+    for (SnakeDirection direction : kDirections) {
+      Cell previous = NeighbourCell(cell, direction);
+      if (Model::Contains(previous) &&
+          layers_[layer].test(Model::CellIndex(previous))) {
+        cell = previous;
+        break;
+      }
+    }
+  }
+  step = cell;
+  return true;
+}
+
+template <int Width, int Height>
+bool BasicAutopilotPolicy<Width, Height>::ReachesTail(
+    const Model &model, Cell new_head) const noexcept {
+  Board free_cells = ~model.GetOccupancy();
+  free_cells.reset(Model::CellIndex(new_head));
+  Board tail;
+  tail.set(Model::CellIndex(model.GetTail()));
+
+  Board region;
+  region.set(Model::CellIndex(new_head));
+  while (true) {
+    Board grown = Expand(region);
+    if ((grown & tail).any()) {
+      return true;
+    }
+    grown &= free_cells;
+    grown |= region;
+    if (grown == region) {
+      return false;
+    }
+    region = grown;
+  }
+}
+
+template <int Width, int Height>
+UserAction_t BasicAutopilotPolicy<Width, Height>::Decide(const Model &model) {
+  const Cell head = model.GetHead();
+  const Cell tail = model.GetTail();
+  SnakeDirection choice = cycle_direction_[Model::CellIndex(head)];
+
+  // Shortcuts are taken only while at least half of the field is free
+  if (Model::kCellCount - model.GetLength() >= Model::kCellCount / 2) {
+    int max_jump = std::min(CycleDistance(head, model.GetApple()),
+                            CycleDistance(head, tail) - kTailBuffer);
+    auto is_shortcut = [&](Cell cell) {
+      if (!IsSafeCell(model, cell)) {
+        return false;
+      }
+      int jump = CycleDistance(head, cell);
+      return jump > 1 && jump <= max_jump && ReachesTail(model, cell);
+    };
+
+    Cell step;
+    if (FindPathStep(model, step) && is_shortcut(step)) {
+      for (SnakeDirection direction : kDirections) {
+        if (NeighbourCell(head, direction) == step) {
+          choice = direction;
+        }
+      }
+    } else {
+      int best_jump = 1;
+      for (SnakeDirection direction : kDirections) {
+        Cell cell = NeighbourCell(head, direction);
+        if (is_shortcut(cell) && CycleDistance(head, cell) > best_jump) {
+          best_jump = CycleDistance(head, cell);
+          choice = direction;
+        }
+      }
+    }
+  }
+
+  // Off the cycle (e.g. right after a manual start) keep at least alive
+  if (!IsSafeCell(model, NeighbourCell(head, choice))) {
+    for (SnakeDirection direction : kDirections) {
+      if (IsSafeCell(model, NeighbourCell(head, direction))) {
+        choice = direction;
+      }
+    }
+  }
+  return DirectionToAction(choice);
+}
+
+template class BasicAutopilotPolicy<kFieldWidth, kFieldHeight>;
+template class BasicAutopilotPolicy<10, 40>;
+template class BasicAutopilotPolicy<32, 32>;
+
+SnakeAutopilot::SnakeAutopilot(SnakeModel *model) : SnakeController(model) {
+  model_->SetPilot(&policy_);
+}
+
+SnakeAutopilot::~SnakeAutopilot() { model_->SetPilot(nullptr); }
+
+void SnakeAutopilot::processUserInput(UserAction_t action, bool hold) {
+  switch (action) {
+    case Start:
+    case Pause:
+    case Terminate:
+      SnakeController::processUserInput(action, hold);
+      break;
+    default:
+      break;
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,76 @@
+#ifndef SNAKE_AUTOPILOT_H
+#define SNAKE_AUTOPILOT_H
+
+#include <array>
+
+#include "snake_controller.h"
+#include "snake_policy.h"
+
+namespace s21 {
+
+/**
+ * @brief Policy that plays the snake to a win.
+ *
+ * The policy follows a precomputed Hamiltonian cycle of the field, which on
+ * its own is guaranteed to fill the whole board. While the board is at most
+ * half full it takes shortcuts: the first step of the BFS shortest path to
+ * the apple, or failing that the farthest safe jump forward along the cycle.
+ * A shortcut is only taken if it keeps the body behind the head in cycle
+ * order and a flood fill from the new head still reaches the tail.
+ *
+ * All searches run on occupancy bitboards, one shift-and-mask step per BFS
+ * layer, so a decision costs well under a microsecond on the standard field.
+ */
+template <int Width, int Height>
+class BasicAutopilotPolicy : public BasicSnakePolicy<Width, Height> {
+  static_assert(Width % 2 == 0,
+                "the Hamiltonian cycle needs an even field width");
+
+ public:
+  using Model = BasicSnakeModel<Width, Height>;
+
+  BasicAutopilotPolicy();
+
+  UserAction_t Decide(const Model &model) override;
+
+ private:
+  using Board = typename Model::Occupancy;
+
+  std::array<int, Model::kCellCount> cycle_index_{};
+  std::array<SnakeDirection, Model::kCellCount> cycle_direction_{};
+  Board left_column_;
+  Board right_column_;
+  std::array<Board, Model::kCellCount> layers_;
+
+  Board Expand(const Board &cells) const noexcept;
+  int CycleDistance(Cell from, Cell to) const noexcept;
+  bool FindPathStep(const Model &model, Cell &step) noexcept;
+  bool ReachesTail(const Model &model, Cell new_head) const noexcept;
+};
+
+using AutopilotPolicy = BasicAutopilotPolicy<kFieldWidth, kFieldHeight>;
+
+extern template class BasicAutopilotPolicy<kFieldWidth, kFieldHeight>;
+extern template class BasicAutopilotPolicy<10, 40>;
+extern template class BasicAutopilotPolicy<32, 32>;
+
+/**
+ * @brief Controller that lets `AutopilotPolicy` steer the snake.
+ *
+ * Start, pause and terminate are still taken from the user; direction keys
+ * and the action key are ignored.
+ */
+class SnakeAutopilot : public SnakeController {
+ public:
+  explicit SnakeAutopilot(SnakeModel *model);
+  ~SnakeAutopilot() override;
+
+  void processUserInput(UserAction_t action, bool hold) override;
+
+ private:
+  AutopilotPolicy policy_;
+};
+
+}  // namespace s21
+
+#endif  // SNAKE_AUTOPILOT_H
@@ -0,0 +1,123 @@
+#ifndef SNAKE_BODY_H
+#define SNAKE_BODY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+
+namespace s21 {
+
+using Cell = std::pair<int8_t, int8_t>;
+
+/**
+ * @brief Two-byte storage form of a Cell, kept trivially copyable so the
+ * body buffer is a plain contiguous block.
+ */
+struct PackedCell {
+  int8_t row;
+  int8_t col;
+};
+
+/**
+ * @brief Fixed-capacity circular buffer holding the snake body from head to
+ * tail.
+ *
+ * All storage lives inside the object, so moving the snake (push_front of the
+ * new head plus pop_back of the tail) never touches the heap. The caller is
+ * responsible for never growing the body past @p Capacity cells.
+ *
+ * @tparam Capacity The maximum number of cells the body can hold.
+ */
+template <std::size_t Capacity>
+class SnakeBody {
+ public:
+  SnakeBody() = default;
+
+  /**
+   * @brief Replaces the body with the given cells, head first.
+   */
+  SnakeBody &operator=(std::initializer_list<Cell> cells) noexcept {
+    clear();
+    for (const auto &cell : cells) {
+      push_back(cell);
+    }
+    return *this;
+  }
+
+  Cell front() const noexcept { return Unpack(cells_[head_]); }
+  Cell back() const noexcept { return Unpack(cells_[Wrap(head_ + size_ - 1)]); }
+
+  std::size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+  static constexpr std::size_t capacity() noexcept { return Capacity; }
+
+  void clear() noexcept {
+    head_ = 0;
+    size_ = 0;
+  }
+
+  /**
+   * @brief Adds a new head cell in front of the current one.
+   */
+  void push_front(Cell cell) noexcept {
+    head_ = head_ == 0 ? Capacity - 1 : head_ - 1;
+    cells_[head_] = Pack(cell);
+    ++size_;
+  }
+
+  /**
+   * @brief Appends a cell behind the current tail.
+   */
+  void push_back(Cell cell) noexcept {
+    cells_[Wrap(head_ + size_)] = Pack(cell);
+    ++size_;
+  }
+
+  void emplace_back(int row, int col) noexcept {
+    push_back(Cell(static_cast<int8_t>(row), static_cast<int8_t>(col)));
+  }
+
+  /**
+   * @brief Drops the tail cell.
+   */
+  void pop_back() noexcept { --size_; }
+
+  /**
+   * @brief Calls @p visit for every cell from head to tail.
+   *
+   * The occupied part of the ring is at most two contiguous runs, so this is
+   * a linear scan over the underlying array.
+   */
+  template <typename Visitor>
+  void ForEach(Visitor &&visit) const {
+    std::size_t first_run =
+        head_ + size_ <= Capacity ? size_ : Capacity - head_;
+    for (std::size_t i = head_; i < head_ + first_run; ++i) {
+      visit(Unpack(cells_[i]));
+    }
+    for (std::size_t i = 0; i < size_ - first_run; ++i) {
+      visit(Unpack(cells_[i]));
+    }
+  }
+
+ private:
+  std::array<PackedCell, Capacity> cells_{};
+  std::size_t head_ = 0;
+  std::size_t size_ = 0;
+
+  static constexpr std::size_t Wrap(std::size_t index) noexcept {
+    return index >= Capacity ? index - Capacity : index;
+  }
+  static constexpr PackedCell Pack(Cell cell) noexcept {
+    return PackedCell{cell.first, cell.second};
+  }
+  static constexpr Cell Unpack(PackedCell cell) noexcept {
+    return Cell(cell.row, cell.col);
+  }
+};
+
+}  // namespace s21
+
+#endif  // SNAKE_BODY_H
@@ -5,12 +5,17 @@ namespace s21 {
 Controller* Controller::instance = nullptr;
 
 SnakeController::SnakeController(SnakeModel* model) : model_(model) {
-  if (instance != nullptr) {
-    throw std::runtime_error("Controller instance already exists.");
+  if (instance == nullptr) {
+    instance = this;
   }
-  instance = this;
 };
 
+SnakeController::~SnakeController() {
+  if (instance == this) {
+    instance = nullptr;
+  }
+}
+
 void SnakeController::UpdateCurrentState() { model_->UpdateCurrentState(); }
 
 void SnakeController::processUserInput(UserAction_t action,
@@ -20,7 +25,12 @@ void SnakeController::processUserInput(UserAction_t action,
 
 }  // namespace s21
 
-GameInfo_t updateCurrentState() { return s21::SnakeModel::game_info; }
+GameInfo_t updateCurrentState() {
+  if (s21::SnakeController::instance == nullptr) {
+    return GameInfo_t{};
+  }
+  return s21::SnakeController::instance->GetGameInfo();
+}
 
 void userInput(UserAction_t action, bool hold) {
   if (s21::SnakeController::instance != nullptr) {
@@ -14,9 +14,13 @@ namespace s21 {
  * The SnakeController class is responsible for processing user input and
  * updating the game state of the Snake game. It interacts with the SnakeModel
  * class to manage the game logic.
+ *
+ * Any number of controllers may exist, one per model. The first one created
+ * becomes `Controller::instance` and serves the `userInput()` and
+ * `updateCurrentState()` bridge functions used by the views.
  */
 class SnakeController : public Controller {
- private:
+ protected:
   SnakeModel *model_;  ///< Pointer to the SnakeModel instance.
 
  public:
@@ -26,6 +30,27 @@ class SnakeController : public Controller {
    */
   explicit SnakeController(SnakeModel *model);
 
+  /**
+   * @brief Releases the C-style bridge if this controller is bound to it.
+   */
+  ~SnakeController() override;
+
+  SnakeController(const SnakeController &) = delete;
+  SnakeController &operator=(const SnakeController &) = delete;
+
+  /**
+   * @brief Returns the state last rendered by the controlled model.
+   */
+  const GameInfo_t &GetGameInfo() const override {
+    return model_->GetGameInfo();
+  }
+  /**
+   * @brief Returns the cells changed by the last model render.
+   */
+  const CellDiff &GetCellDiff() const override {
+    return model_->GetCellDiff();
+  }
+
   /**
    * @brief Updates the current game state.
    *
@@ -1,60 +1,47 @@
 #include "snake_model.h"
 
+#include "snake_policy.h"
+
 // namespace s21
 namespace s21 {
 
-GameInfo_t SnakeModel::game_info{};
-SnakeModel *SnakeModel::instance = nullptr;
-
-SnakeModel::SnakeModel(const std::string &runtime_path_)
-    : runtime_path_(runtime_path_), rand_engine_(std::random_device{}()) {
-  // LCOV_EXCL_START
-  if (instance != nullptr) {
-    throw std::runtime_error("Model instance already exists.");
-  }
-  // LCOV_EXCL_STOP
-  instance = this;
-
+template <int Width, int Height>
+BasicSnakeModel<Width, Height>::BasicSnakeModel(
+    const std::string &runtime_path_, GameClock *clock, uint32_t seed)
+    : runtime_path_(runtime_path_),
+      timestep_(clock != nullptr ? clock : DefaultGameClock(),
+                std::chrono::milliseconds(kTickInMs), kMaxCatchUpTicks),
+      seed_(seed),
+      rand_engine_(seed) {
   for (int i = 0; i < kInitialSnakeLength; ++i) {
-    snake_.emplace_back(                               // LCOV_EXCL_LINE
-        (kFieldHeight - kInitialSnakeLength) / 2 + i,  // LCOV_EXCL_LINE
-        kFieldWidth / 2);                              // LCOV_EXCL_LINE
+    snake_.emplace_back(                         // LCOV_EXCL_LINE
+        (Height - kInitialSnakeLength) / 2 + i,  // LCOV_EXCL_LINE
+        Width / 2);                              // LCOV_EXCL_LINE
   }
+  RebuildOccupancy();
 
-  game_info.next = nullptr;
-  game_info.speed = 1;
+  for (int i = 0; i < Height; i++) {
+    field_rows_[i] = field_[i].data();
+  }
+  game_info_.field = field_rows_.data();
+  game_info_.next = nullptr;
+  game_info_.speed = 1;
 
   LoadHighScore();
-  game_info.high_score = high_score_;
-
-  AllocateGameInfoField();
+  game_info_.high_score = high_score_;
+  if (!runtime_path_.empty()) {
+    high_score_writer_ = std::make_unique<HighScoreWriter>(
+        std::filesystem::path(runtime_path_) / kHighScoreFileName);
+  }
 
   GenerateApple();
 }
 
-SnakeModel::~SnakeModel() { DeallocateGameInfoField(); }
-
-void SnakeModel::AllocateGameInfoField() noexcept {
-  try {
-    game_info.field = new int *[kFieldHeight];
-    for (int i = 0; i < kFieldHeight; i++) {
-      game_info.field[i] = new int[kFieldWidth]{0};
-    }
-    // LCOV_EXCL_START
-  } catch (std::bad_alloc &e) {
-    std::cerr << "Memory allocation failed: " << e.what() << std::endl;
-  }
-  // LCOV_EXCL_STOP
-}
-
-void SnakeModel::DeallocateGameInfoField() noexcept {
-  for (int i = 0; i < kFieldHeight; i++) {
-    delete[] game_info.field[i];
+template <int Width, int Height>
+void BasicSnakeModel<Width, Height>::LoadHighScore() {
+  if (runtime_path_.empty()) {
+    return;
   }
-  delete[] game_info.field;
-}
-
-void SnakeModel::LoadHighScore() {
   std::filesystem::path score_path =
       std::filesystem::path(runtime_path_) / kHighScoreFileName;
   if (std::ifstream fs(score_path); fs.is_open()) {
@@ -62,50 +49,87 @@ void SnakeModel::LoadHighScore() {
   }
 }
 
-void SnakeModel::StoreHighScore() {
-  std::filesystem::path score_path =
-      std::filesystem::path(runtime_path_) / kHighScoreFileName;
+template <int Width, int Height>
+void BasicSnakeModel<Width, Height>::StoreHighScore() {
+  if (high_score_writer_ == nullptr) {
+    return;
+  }
+  high_score_writer_->Submit(high_score_);
+}
 
-  if (std::ofstream fs(score_path); fs.is_open()) {
-    fs << high_score_;
+template <int Width, int Height>
+void BasicSnakeModel<Width, Height>::UpdateCurrentState() noexcept {
+  for (int ticks = timestep_.Consume(); ticks > 0; --ticks) {
+    Tick();
+  }
+
+  cell_diff_.Clear();
+  if (repaint_all_) {
+    std::array<std::array<int, Width>, Height> frame{};
+    snake_.ForEach([&frame](Cell segment) {
+      frame[segment.first][segment.second] = static_cast<int>(Colors::kGreen);
+    });
+    frame[apple_.first][apple_.second] = static_cast<int>(Colors::kRed);
+    for (int row = 0; row < Height; ++row) {
+      for (int col = 0; col < Width; ++col) {
+        RepaintCell(row, col, frame[row][col]);
+      }
+    }
+    repaint_all_ = false;
   } else {
-    // LCOV_EXCL_START
-    std::cerr << "Error: Unable to open snake_high_score.txt" << std::endl;
-    // LCOV_EXCL_STOP
+    for (int i = 0; i < dirty_count_; ++i) {
+      int idx = dirty_cells_[i];
+      Cell cell(idx / Width, idx % Width);
+      int color = 0;
+      if (cell == apple_) {
+        color = static_cast<int>(Colors::kRed);
+      } else if (occupancy_.test(idx)) {
+        color = static_cast<int>(Colors::kGreen);
+      }
+      RepaintCell(cell.first, cell.second, color);
+    }
   }
+  dirty_count_ = 0;
+
+  game_info_.score = score_;
+  game_info_.high_score = high_score_;
+  game_info_.level = level_;
+  game_info_.speed = speed_;
+  game_info_.pause = game_state_ == GameState::kOnPause;
 }
 
-void SnakeModel::UpdateCurrentState() noexcept {
-  auto current_time_in_ms = std::chrono::system_clock::now();
-  auto elapsed_time_in_ms =
-      std::chrono::duration_cast<std::chrono::milliseconds>(current_time_in_ms -
-                                                            frame_start_in_ms_)
-          .count();
-  // LCOV_EXCL_START
-  if (elapsed_time_in_ms >
-      (kInitialDelayInMs -
-       kDelayReducePerLevelInMs * updateCurrentState().level)) {
-    frame_start_in_ms_ = current_time_in_ms;
-    userInput(UserAction_t::Action, false);
-  }
-  // LCOV_EXCL_STOP
-  for (int i = 0; i < kFieldHeight; ++i) {
-    std::fill(game_info.field[i], game_info.field[i] + kFieldWidth, 0);
+template <int Width, int Height>
+bool BasicSnakeModel<Width, Height>::Tick() noexcept {
+  const bool move_due = game_state_ == GameState::kRunning &&
+                        tick_ + 1 - last_move_tick_ >=
+                            kMoveCooldownInTicks + MoveDelayInTicks();
+  // The pilot steers between two ticks like a user would, so its decisions
+  // are recorded and replayed exactly like user input.
+  if (move_due && pilot_ != nullptr) {
+    FSM(pilot_->Decide(*this));
   }
 
-  for (const auto &[row, col] : snake_) {
-    game_info.field[row][col] = static_cast<int>(Colors::kGreen);
+  ++tick_;
+  if (game_state_ != GameState::kRunning) {
+    // Hold the move timer while the game is not running, so the first
+    // automove comes a full delay after start or resume.
+    last_move_tick_ = tick_ - kMoveCooldownInTicks;
+  } else if (move_due) {
+    HandleAction(UserAction_t::Action);
   }
+  if (recorder_ != nullptr) {
+    recorder_->SetEndTick(tick_);
+  }
+  return last_move_tick_ == tick_;
+}
 
-  game_info.field[apple_.first][apple_.second] = static_cast<int>(Colors::kRed);
-  game_info.score = score_;
-  game_info.high_score = high_score_;
-  game_info.level = level_;
-  game_info.speed = speed_;
-  game_info.pause = game_state_ == GameState::kOnPause;
+template <int Width, int Height>
+int BasicSnakeModel<Width, Height>::MoveDelayInTicks() const noexcept {
+  return (kInitialDelayInMs - kDelayReducePerLevelInMs * level_) / kTickInMs;
 }
 
-void SnakeModel::UpdateDirection() noexcept {
+template <int Width, int Height>
+void BasicSnakeModel<Width, Height>::UpdateDirection() noexcept {
   // Define the opposite direction of each possible direction
   static const std::unordered_map<SnakeDirection, SnakeDirection> opposites = {
       {SnakeDirection::kUp, SnakeDirection::kDown},
@@ -124,7 +148,17 @@ void SnakeModel::UpdateDirection() noexcept {
   next_direction_ = direction_;
 }
 
-void SnakeModel::FSM(UserAction_t action) noexcept {
+template <int Width, int Height>
+void BasicSnakeModel<Width, Height>::FSM(UserAction_t action) noexcept {
+  if (recorder_ != nullptr) {
+    recorder_->Append(tick_, action);
+  }
+  HandleAction(action);
+}
+
+template <int Width, int Height>
+void BasicSnakeModel<Width, Height>::HandleAction(
+    UserAction_t action) noexcept {
   switch (action) {
     case Start:
       if (game_state_ == GameState::kStart) {
@@ -140,7 +174,7 @@ void SnakeModel::FSM(UserAction_t action) noexcept {
       }
       break;
     case Terminate:
-      game_state_ = GameState::kGameOver;
+      FinishGame();
       break;
     case Left:
       next_direction_ = SnakeDirection::kLeft;
@@ -155,29 +189,26 @@ void SnakeModel::FSM(UserAction_t action) noexcept {
       next_direction_ = SnakeDirection::kDown;
       break;
     case Action:
-      if (game_state_ == GameState::kRunning) {
-        if (frame_start_in_ms_ < std::chrono::system_clock::now()) {
-          MoveOneStepForward();
-          frame_start_in_ms_ =
-              std::chrono::system_clock::now() + std::chrono::milliseconds(50);
-        }
+      if (game_state_ == GameState::kRunning &&
+          tick_ - last_move_tick_ >= kMoveCooldownInTicks) {
+        MoveOneStepForward();
+        last_move_tick_ = tick_;
       }
       break;
     default:  // LCOV_EXCL_LINE
       break;  // LCOV_EXCL_LINE
   }
 }
-CollisionType SnakeModel::CheckCollision(Cell next_head) noexcept {
+template <int Width, int Height>
+CollisionType BasicSnakeModel<Width, Height>::CheckCollision(
+    Cell next_head) noexcept {
   // Check for wall collision
-  if (next_head.first < 0 || next_head.first >= kFieldHeight ||
-      next_head.second < 0 || next_head.second >= kFieldWidth) {
+  if (!Contains(next_head)) {
     return CollisionType::kWall;
   }
 
   // Check for snake collision
-  if (std::any_of(
-          snake_.begin(), snake_.end(),
-          [&next_head](const auto &segment) { return segment == next_head; })) {
+  if (occupancy_.test(CellIndex(next_head))) {
     return CollisionType::kSnake;
   }
 
@@ -190,7 +221,8 @@ CollisionType SnakeModel::CheckCollision(Cell next_head) noexcept {
   return CollisionType::kNone;
 }
 
-void SnakeModel::MoveOneStepForward() noexcept {
+template <int Width, int Height>
+void BasicSnakeModel<Width, Height>::MoveOneStepForward() noexcept {
   if (game_state_ != GameState::kRunning) {
     return;
   }
@@ -218,21 +250,25 @@ void SnakeModel::MoveOneStepForward() noexcept {
   switch (collision) {
     case CollisionType::kWall:
     case CollisionType::kSnake:
-      game_state_ = GameState::kGameOver;
       level_ = kLoose;
+      FinishGame();
       return;
     case CollisionType::kApple:
       EatApple();
       return;
     case CollisionType::kNone:
       snake_.push_front(newHead);
+      OccupyCell(newHead);
+      VacateCell(snake_.back());
       snake_.pop_back();
       return;
   }
 }
 
-void SnakeModel::EatApple() noexcept {
+template <int Width, int Height>
+void BasicSnakeModel<Width, Height>::EatApple() noexcept {
   snake_.push_front(apple_);
+  OccupyCell(apple_);
   score_++;
   if (score_ > high_score_) {
     high_score_ = score_;
@@ -241,35 +277,95 @@ void SnakeModel::EatApple() noexcept {
   if (score_ % 5 == 0 && level_ < kMaxLevel) {
     level_++;
   }
-  if (snake_.size() == kSnakeSizeToWin) {
-    game_state_ = GameState::kGameOver;
+  if (snake_.size() == kSizeToWin) {
     level_ = kWin;
+    FinishGame();
   } else {
     GenerateApple();
   }
 }
 
-void SnakeModel::GenerateApple() noexcept {
-  std::vector<Cell> empty_cells;
-  empty_cells.reserve(kFieldHeight * kFieldWidth);
+template <int Width, int Height>
+void BasicSnakeModel<Width, Height>::FinishGame() noexcept {
+  game_state_ = GameState::kGameOver;
+  if (high_score_writer_ != nullptr) {
+    high_score_writer_->Flush();
+  }
+}
 
-  for (int i = 0; i < kFieldHeight; i++) {
-    for (int j = 0; j < kFieldWidth; j++) {
-      if (game_info.field[i][j] == 0) {
-        empty_cells.push_back({i, j});
-      }
+template <int Width, int Height>
+void BasicSnakeModel<Width, Height>::RepaintCell(int row, int col,
+                                                 int color) noexcept {
+  if (field_[row][col] != color) {
+    field_[row][col] = color;
+    cell_diff_.Add(row, col, color);
+  }
+}
+
+template <int Width, int Height>
+void BasicSnakeModel<Width, Height>::MarkDirty(Cell cell) noexcept {
+  if (repaint_all_) {
+    return;
+  }
+  if (dirty_count_ == kMaxDirtyCells) {
+    repaint_all_ = true;
+    return;
+  }
+  dirty_cells_[dirty_count_++] = static_cast<uint16_t>(CellIndex(cell));
+}
+
+template <int Width, int Height>
+void BasicSnakeModel<Width, Height>::RebuildOccupancy() noexcept {
+  repaint_all_ = true;
+  occupancy_.reset();
+  snake_.ForEach([this](Cell segment) { occupancy_.set(CellIndex(segment)); });
+
+  free_count_ = 0;
+  for (int idx = 0; idx < kCellCount; ++idx) {
+    if (!occupancy_.test(idx)) {
+      free_slot_[idx] = static_cast<uint16_t>(free_count_);
+      free_cells_[free_count_++] = static_cast<uint16_t>(idx);
     }
   }
+}
+
+template <int Width, int Height>
+void BasicSnakeModel<Width, Height>::OccupyCell(Cell cell) noexcept {
+  int idx = CellIndex(cell);
+  occupancy_.set(idx);
+  MarkDirty(cell);
+  // Swap-remove the cell from the dense free list
+  uint16_t last = free_cells_[--free_count_];
+  free_cells_[free_slot_[idx]] = last;
+  free_slot_[last] = free_slot_[idx];
+}
 
-  if (empty_cells.empty()) {
-    game_state_ = GameState::kGameOver;
+template <int Width, int Height>
+void BasicSnakeModel<Width, Height>::VacateCell(Cell cell) noexcept {
+  int idx = CellIndex(cell);
+  occupancy_.reset(idx);
+  MarkDirty(cell);
+  free_slot_[idx] = static_cast<uint16_t>(free_count_);
+  free_cells_[free_count_++] = static_cast<uint16_t>(idx);
+}
+
+template <int Width, int Height>
+void BasicSnakeModel<Width, Height>::GenerateApple() noexcept {
+  if (free_count_ == 0) {
     level_ = kWin;
+    FinishGame();
   } else {
-    std::uniform_int_distribution random_int_distribution{
-        0UL, empty_cells.size() - 1};  // Generate a random index
-    size_t idx = random_int_distribution(rand_engine_);
-    apple_ = empty_cells[idx];
+    std::uniform_int_distribution<int> random_int_distribution{
+        0, free_count_ - 1};  // Generate a random index
+    int idx = free_cells_[random_int_distribution(rand_engine_)];
+    MarkDirty(apple_);
+    apple_ = Cell(idx / Width, idx % Width);
+    MarkDirty(apple_);
   }
 }
 
+template class BasicSnakeModel<kFieldWidth, kFieldHeight>;
+template class BasicSnakeModel<10, 40>;
+template class BasicSnakeModel<32, 32>;
+
 }  // namespace s21
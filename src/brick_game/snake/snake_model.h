@@ -4,19 +4,25 @@
 #include <libgen.h>
 
 #include <algorithm>
+#include <array>
+#include <bitset>
 #include <chrono>
 #include <cstdint>
-#include <deque>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
-#include <list>
+#include <memory>
 #include <random>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "../cell_diff.h"
 #include "../common.h"
+#include "../game_clock.h"
+#include "../high_score_writer.h"
+#include "snake_body.h"
+#include "snake_replay.h"
 
 namespace s21 {
 
@@ -76,6 +82,26 @@ enum class Colors {
  */
 constexpr int kInitialDelayInMs = 400;
 
+/**
+ * @brief The length of one fixed simulation tick of the snake game in
+ * milliseconds. All game delays are whole multiples of it.
+ */
+constexpr int kTickInMs = 25;
+
+/**
+ * @brief The minimum time between two moves of the snake in milliseconds. It
+ * limits how fast the player can push the snake with the action key and is
+ * added to every automove delay.
+ */
+constexpr int kMoveCooldownInMs = 50;
+constexpr int kMoveCooldownInTicks = kMoveCooldownInMs / kTickInMs;
+
+/**
+ * @brief The largest number of ticks simulated in one update. A bigger backlog
+ * (e.g. after the process was suspended) is dropped.
+ */
+constexpr int kMaxCatchUpTicks = 1000 / kTickInMs;
+
 /**
  * @brief The initial length of the snake in the game.
  */
@@ -91,40 +117,90 @@ constexpr int kDelayReducePerLevelInMs = 25;
  */
 constexpr int kMaxLevel = 10;
 
-/**
- * @brief The size of the snake that the player must reach to win the game.
- */
-constexpr int kSnakeSizeToWin = kFieldHeight * kFieldWidth;
-
 /**
  * @brief The name of the file that stores the high score for the Snake game.
  */
 constexpr std::string_view kHighScoreFileName = "snake_high_score.txt";
 
-using Cell = std::pair<int8_t, int8_t>;
+template <int Width, int Height>
+class BasicSnakePolicy;
 
 /**
- * @brief The SnakeModel class represents the game logic for the Snake game.
- * It manages the state of the game, including the snake's position and
+ * @brief The BasicSnakeModel class represents the game logic for the Snake
+ * game. It manages the state of the game, including the snake's position and
  * direction, the apple's position, the score, and the game state.
+ *
+ * The field dimensions are template parameters, so every board size gets its
+ * own fixed-size storage and constant-bound loops. The sizes used by the
+ * project are instantiated once in snake_model.cc.
+ *
+ * @tparam Width The number of columns of the field.
+ * @tparam Height The number of rows of the field.
  */
-class SnakeModel {
+template <int Width, int Height>
+class BasicSnakeModel {
+  static_assert(Width >= 2 && Width <= INT8_MAX &&
+                    Height >= kInitialSnakeLength && Height <= INT8_MAX,
+                "field cells must fit the int8_t coordinates of Cell");
+
  public:
+  static constexpr int kWidth = Width;
+  static constexpr int kHeight = Height;
+
+  /**
+   * @brief The total number of cells on the game field.
+   */
+  static constexpr int kCellCount = Width * Height;
+  static_assert(kCellCount <= UINT16_MAX,
+                "free cell indices must fit into uint16_t");
+
   /**
-   * @brief Constructs a SnakeModel instance with the given runtime path.
-   * @param runtime_path_ The path to the runtime directory.
+   * @brief The size of the snake that the player must reach to win the game.
    */
-  explicit SnakeModel(const std::string &runtime_path_);
+  static constexpr int kSizeToWin = kCellCount;
 
   /**
-   * @brief Destructor for the SnakeModel class.
+   * @brief One bit per field cell, set where the snake body lies.
    */
-  ~SnakeModel();
+  using Occupancy = std::bitset<kCellCount>;
 
-  SnakeModel(const SnakeModel &) = delete;
-  SnakeModel &operator=(const SnakeModel &) = delete;
-  SnakeModel(SnakeModel &&) = delete;
-  SnakeModel &operator=(SnakeModel &&) = delete;
+  /**
+   * @brief Returns the row-major bit index of the given cell.
+   */
+  static constexpr int CellIndex(Cell cell) noexcept {
+    return cell.first * Width + cell.second;
+  }
+
+  /**
+   * @brief Returns true if @p cell lies on the field.
+   */
+  static constexpr bool Contains(Cell cell) noexcept {
+    return cell.first >= 0 && cell.first < Height && cell.second >= 0 &&
+           cell.second < Width;
+  }
+
+  /**
+   * @brief Constructs a model instance with the given runtime path.
+   * @param runtime_path_ The path to the runtime directory, or an empty string
+   * to disable high score persistence (e.g. for headless runs).
+   * @param clock The time source driving the game, or nullptr for the
+   * real-time default clock.
+   * @param seed The seed of the apple placement random engine. It is kept
+   * and can be read back with `GetSeed()`, so any game can be replayed.
+   */
+  explicit BasicSnakeModel(const std::string &runtime_path_,
+                           GameClock *clock = nullptr,
+                           uint32_t seed = std::random_device{}());
+
+  /**
+   * @brief Destructor for the BasicSnakeModel class.
+   */
+  ~BasicSnakeModel() = default;
+
+  BasicSnakeModel(const BasicSnakeModel &) = delete;
+  BasicSnakeModel &operator=(const BasicSnakeModel &) = delete;
+  BasicSnakeModel(BasicSnakeModel &&) = delete;
+  BasicSnakeModel &operator=(BasicSnakeModel &&) = delete;
 
   /**
    * @brief Loads the high score from a file.
@@ -132,26 +208,92 @@ class SnakeModel {
   void LoadHighScore();
 
   /**
-   * @brief Stores the current high score to a file.
+   * @brief Hands the current high score to the background writer, which
+   * stores it to a file without blocking the game.
    */
   void StoreHighScore();
 
   /**
-   * @brief Updates the current state of the game based on user actions.
+   * @brief Runs the ticks that came due on the clock and renders the current
+   * state of the game into this model's `GameInfo_t`.
    */
   void UpdateCurrentState() noexcept;
 
+  /**
+   * @brief Advances the simulation by exactly one fixed tick, moving the
+   * snake when its automove delay has passed.
+   * @return true if the snake moved on this tick.
+   */
+  bool Tick() noexcept;
+
   /**
    * @brief Handles the Finite State Machine (FSM) transitions based on user
-   * actions.
+   * actions. The action is appended to the attached replay, if any.
    * @param action The user action to be processed.
    */
   void FSM(UserAction_t action) noexcept;
 
+  /**
+   * @brief Returns the state rendered by the last `UpdateCurrentState()`.
+   *
+   * The field rows point into buffers owned by this model, so the returned
+   * structure stays valid for the model's lifetime.
+   */
+  const GameInfo_t &GetGameInfo() const noexcept { return game_info_; }
+
+  /**
+   * @brief Returns the field cells the last `UpdateCurrentState()` changed.
+   */
+  const BasicCellDiff<kCellCount> &GetCellDiff() const noexcept {
+    return cell_diff_;
+  }
+
+  Cell GetHead() const noexcept { return snake_.front(); }
+  Cell GetTail() const noexcept { return snake_.back(); }
+  Cell GetApple() const noexcept { return apple_; }
+  int GetLength() const noexcept { return static_cast<int>(snake_.size()); }
+  int GetScore() const noexcept { return score_; }
+  int GetLevel() const noexcept { return level_; }
+  SnakeDirection GetDirection() const noexcept { return direction_; }
+  GameState GetGameState() const noexcept { return game_state_; }
+  uint32_t GetSeed() const noexcept { return seed_; }
+  int64_t GetTick() const noexcept { return tick_; }
+  const Occupancy &GetOccupancy() const noexcept { return occupancy_; }
+
+  /**
+   * @brief Lets @p pilot choose the direction right before every automove.
+   * @param pilot The policy to consult, or nullptr to return control to the
+   * user input.
+   */
+  void SetPilot(BasicSnakePolicy<Width, Height> *pilot) noexcept {
+    pilot_ = pilot;
+  }
+
+  /**
+   * @brief Records every following input, including the pilot's decisions,
+   * into @p replay, which is reset to this model's seed and size first.
+   *
+   * Attach the recorder before the first tick and input, so the replay
+   * starts from the state a fresh model is constructed in.
+   * @param replay The replay to record into, or nullptr to stop recording.
+   */
+  void SetRecorder(SnakeReplay *replay) {
+    recorder_ = replay;
+    if (recorder_ != nullptr) {
+      recorder_->Reset(seed_, Width, Height);
+      recorder_->SetEndTick(tick_);
+    }
+  }
+
  private:
-  static SnakeModel *instance;
   std::string runtime_path_;
-  std::list<Cell> snake_;
+  SnakeBody<kCellCount> snake_;
+  Occupancy occupancy_;
+  // Dense list of the cells not covered by the snake plus, for every cell,
+  // its slot in that list, so a cell moves in or out of the set in O(1).
+  std::array<uint16_t, kCellCount> free_cells_{};
+  std::array<uint16_t, kCellCount> free_slot_{};
+  int free_count_{0};
   SnakeDirection direction_ = SnakeDirection::kUp;
   SnakeDirection next_direction_ = SnakeDirection::kUp;
   Cell apple_{0, 0};
@@ -160,25 +302,44 @@ class SnakeModel {
   int level_{0};
   int speed_{1};
   GameState game_state_ = GameState::kStart;
-  std::chrono::_V2::system_clock::time_point frame_start_in_ms_ =
-      std::chrono::system_clock::now();
+  FixedTimestep timestep_;
+  int64_t tick_{0};
+  int64_t last_move_tick_{-kMoveCooldownInTicks};
+  uint32_t seed_;
   std::mt19937 rand_engine_;
-  std::uniform_int_distribution<size_t> random_int_distribution_;
+  BasicSnakePolicy<Width, Height> *pilot_{nullptr};
+  SnakeReplay *recorder_{nullptr};
+  std::unique_ptr<HighScoreWriter> high_score_writer_;
+  std::array<std::array<int, Width>, Height> field_{};
+  std::array<int *, Height> field_rows_{};
+  GameInfo_t game_info_{};
+  // Cells the snake or the apple entered or left since the last render. A
+  // cell may be listed twice; once the list is full, or after a rebuild, the
+  // next render repaints the whole field instead.
+  static constexpr int kMaxDirtyCells = 64;
+  std::array<uint16_t, kMaxDirtyCells> dirty_cells_{};
+  int dirty_count_{0};
+  bool repaint_all_{true};
+  BasicCellDiff<kCellCount> cell_diff_;
 
+  void HandleAction(UserAction_t action) noexcept;
   void MoveOneStepForward() noexcept;
 
   CollisionType CheckCollision(Cell next_head) noexcept;
   void GenerateApple() noexcept;
   void EatApple() noexcept;
+  void FinishGame() noexcept;
   void UpdateScore() noexcept;
+  void RebuildOccupancy() noexcept;
+  void OccupyCell(Cell cell) noexcept;
+  void VacateCell(Cell cell) noexcept;
+  void MarkDirty(Cell cell) noexcept;
+  void RepaintCell(int row, int col, int color) noexcept;
 
   void UpdateDirection() noexcept;
-  void AllocateGameInfoField() noexcept;
-  void DeallocateGameInfoField() noexcept;
+  int MoveDelayInTicks() const noexcept;
 
  public:
-  static GameInfo_t game_info;
-
   // for testing purposes
   friend class SnakeModelTest;
   friend class SnakeModelTest_Initialization_Test;
@@ -191,7 +352,52 @@ class SnakeModel {
   friend class SnakeModelTest_GenerateApple_Test;
   friend class SnakeModelTest_FSMStateTransitions_Test;
   friend class SnakeModelTest_CheckWinGame_Test;
+  friend class SnakeModelTest_OccupancyFollowsSnake_Test;
+  friend class SnakeModelTest_FreeCellsFollowSnake_Test;
+  friend class SnakeModelTest_TickDrivesAutomove_Test;
+  friend class SnakeModelTest_InstancesAreIndependent_Test;
+  // for benchmarking purposes
+  friend class SnakeModelBenchmark;
 };
 
+/**
+ * @brief The snake game on the standard field shown by the views.
+ */
+using SnakeModel = BasicSnakeModel<kFieldWidth, kFieldHeight>;
+/**
+ * @brief Double-height field, e.g. for tall terminals.
+ */
+using TallSnakeModel = BasicSnakeModel<10, 40>;
+/**
+ * @brief Square field, big enough to stress the long-snake paths.
+ */
+using SquareSnakeModel = BasicSnakeModel<32, 32>;
+
+extern template class BasicSnakeModel<kFieldWidth, kFieldHeight>;
+extern template class BasicSnakeModel<10, 40>;
+extern template class BasicSnakeModel<32, 32>;
+
+/**
+ * @brief The total number of cells on the standard game field.
+ */
+constexpr int kFieldCellCount = SnakeModel::kCellCount;
+
+/**
+ * @brief The size of the snake that the player must reach to win the game.
+ */
+constexpr int kSnakeSizeToWin = SnakeModel::kSizeToWin;
+
+/**
+ * @brief One bit per cell of the standard field, set where the snake lies.
+ */
+using OccupancyBoard = SnakeModel::Occupancy;
+
+/**
+ * @brief Returns the row-major bit index of a cell of the standard field.
+ */
+constexpr int CellIndex(Cell cell) noexcept {
+  return SnakeModel::CellIndex(cell);
+}
+
 }  // namespace s21
 #endif  // SNAKE_MODEL_H
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "snake_policy.h"
+
+#include <cstdlib>
+
+namespace s21 {
+
+namespace {
+
+constexpr SnakeDirection kDirections[] = {
+    SnakeDirection::kUp, SnakeDirection::kDown, SnakeDirection::kLeft,
+    SnakeDirection::kRight};
+
+int ManhattanDistance(Cell a, Cell b) noexcept {
+  return std::abs(a.first - b.first) + std::abs(a.second - b.second);
+}
+
+}  // namespace
+
+Cell NeighbourCell(Cell cell, SnakeDirection direction) noexcept {
+  switch (direction) {
+    case SnakeDirection::kUp:
+      cell.first--;
+      break;
+    case SnakeDirection::kDown:
+      cell.first++;
+      break;
+    case SnakeDirection::kLeft:
+      cell.second--;
+      break;
+    case SnakeDirection::kRight:
+      cell.second++;
+      break;
+  }
+  return cell;
+}
+
+UserAction_t DirectionToAction(SnakeDirection direction) noexcept {
+  switch (direction) {
+    case SnakeDirection::kUp:
+      return UserAction_t::Up;
+    case SnakeDirection::kDown:
+      return UserAction_t::Down;
+    case SnakeDirection::kLeft:
+      return UserAction_t::Left;
+    default:
+      return UserAction_t::Right;
+  }
+}
+
+template <int Width, int Height>
+UserAction_t BasicRandomPolicy<Width, Height>::Decide(
+    const BasicSnakeModel<Width, Height> &model) {
+  SnakeDirection safe[4];
+  int safe_count = 0;
+  for (SnakeDirection direction : kDirections) {
+    if (IsSafeCell(model, NeighbourCell(model.GetHead(), direction))) {
+      safe[safe_count++] = direction;
+    }
+  }
+  if (safe_count == 0) {
+    return DirectionToAction(model.GetDirection());
+  }
+  std::uniform_int_distribution<int> pick{0, safe_count - 1};
+  return DirectionToAction(safe[pick(rand_engine_)]);
+}
+
+template <int Width, int Height>
+UserAction_t BasicGreedyPolicy<Width, Height>::Decide(
+    const BasicSnakeModel<Width, Height> &model) {
+  SnakeDirection best = model.GetDirection();
+  int best_distance = Width + Height;
+  for (SnakeDirection direction : kDirections) {
+    Cell next = NeighbourCell(model.GetHead(), direction);
+    int distance = ManhattanDistance(next, model.GetApple());
+    if (IsSafeCell(model, next) && distance < best_distance) {
+      best = direction;
+      best_distance = distance;
+    }
+  }
+  return DirectionToAction(best);
+}
+
+template class BasicRandomPolicy<kFieldWidth, kFieldHeight>;
+template class BasicRandomPolicy<10, 40>;
+template class BasicRandomPolicy<32, 32>;
+template class BasicGreedyPolicy<kFieldWidth, kFieldHeight>;
+template class BasicGreedyPolicy<10, 40>;
+template class BasicGreedyPolicy<32, 32>;
+
+}  // namespace s21
@@ -0,0 +1,88 @@
+#ifndef SNAKE_POLICY_H
+#define SNAKE_POLICY_H
+
+#include <cstdint>
+#include <random>
+
+#include "snake_model.h"
+
+namespace s21 {
+
+/**
+ * @brief Returns the cell next to @p cell in the given direction.
+ */
+Cell NeighbourCell(Cell cell, SnakeDirection direction) noexcept;
+
+/**
+ * @brief Returns the user action that turns the snake to @p direction.
+ */
+UserAction_t DirectionToAction(SnakeDirection direction) noexcept;
+
+/**
+ * @brief Returns true if the snake can step into @p cell without dying.
+ */
+template <int Width, int Height>
+bool IsSafeCell(const BasicSnakeModel<Width, Height> &model,
+                Cell cell) noexcept {
+  return BasicSnakeModel<Width, Height>::Contains(cell) &&
+         !model.GetOccupancy().test(
+             BasicSnakeModel<Width, Height>::CellIndex(cell));
+}
+
+/**
+ * @brief Interface of an automatic snake player.
+ *
+ * A policy looks at the model right before the snake moves and chooses the
+ * direction of the next step. Policies are used by headless drivers such as
+ * the self-play runner, one policy object per game.
+ */
+template <int Width, int Height>
+class BasicSnakePolicy {
+ public:
+  virtual ~BasicSnakePolicy() = default;
+
+  /**
+   * @brief Chooses the direction of the next step.
+   * @param model The game to decide for.
+   * @return One of UserAction_t::Up, Down, Left or Right.
+   */
+  virtual UserAction_t Decide(const BasicSnakeModel<Width, Height> &model) = 0;
+};
+
+/**
+ * @brief Policy that picks a random direction among the ones that do not kill
+ * the snake on the next step.
+ */
+template <int Width, int Height>
+class BasicRandomPolicy : public BasicSnakePolicy<Width, Height> {
+ public:
+  explicit BasicRandomPolicy(uint32_t seed) : rand_engine_(seed) {}
+  UserAction_t Decide(const BasicSnakeModel<Width, Height> &model) override;
+
+ private:
+  std::mt19937 rand_engine_;
+};
+
+/**
+ * @brief Policy that steps to the safe neighbour closest to the apple.
+ */
+template <int Width, int Height>
+class BasicGreedyPolicy : public BasicSnakePolicy<Width, Height> {
+ public:
+  UserAction_t Decide(const BasicSnakeModel<Width, Height> &model) override;
+};
+
+using SnakePolicy = BasicSnakePolicy<kFieldWidth, kFieldHeight>;
+using RandomPolicy = BasicRandomPolicy<kFieldWidth, kFieldHeight>;
+using GreedyPolicy = BasicGreedyPolicy<kFieldWidth, kFieldHeight>;
+
+extern template class BasicRandomPolicy<kFieldWidth, kFieldHeight>;
+extern template class BasicRandomPolicy<10, 40>;
+extern template class BasicRandomPolicy<32, 32>;
+extern template class BasicGreedyPolicy<kFieldWidth, kFieldHeight>;
+extern template class BasicGreedyPolicy<10, 40>;
+extern template class BasicGreedyPolicy<32, 32>;
+
+}  // namespace s21
+
+#endif  // SNAKE_POLICY_H
@@ -0,0 +1,131 @@
+#include "snake_replay.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+namespace s21 {
+
+namespace {
+
+constexpr uint8_t kMagic[] = {'S', 'N', 'K', 'R'};
+constexpr uint8_t kFormatVersion = 1;
+
+}  // namespace
+
+void SnakeReplay::Reset(uint32_t seed, int width, int height) {
+  seed_ = seed;
+  width_ = width;
+  height_ = height;
+  last_tick_ = 0;
+  end_tick_ = 0;
+  input_count_ = 0;
+  inputs_.clear();
+}
+
+void SnakeReplay::Append(int64_t tick, UserAction_t action) {
+  uint64_t delta = static_cast<uint64_t>(tick - last_tick_);
+  EncodeVarint(delta << kActionBits | static_cast<uint64_t>(action), inputs_);
+  last_tick_ = tick;
+  ++input_count_;
+}
+
+std::vector<uint8_t> SnakeReplay::Serialize() const {
+  std::vector<uint8_t> bytes(std::begin(kMagic), std::end(kMagic));
+  bytes.push_back(kFormatVersion);
+  EncodeVarint(static_cast<uint64_t>(width_), bytes);
+  EncodeVarint(static_cast<uint64_t>(height_), bytes);
+  EncodeVarint(seed_, bytes);
+  EncodeVarint(static_cast<uint64_t>(end_tick_), bytes);
+  EncodeVarint(input_count_, bytes);
+  bytes.insert(bytes.end(), inputs_.begin(), inputs_.end());
+  return bytes;
+}
+
+bool SnakeReplay::Deserialize(const std::vector<uint8_t> &bytes) {
+  std::size_t pos = std::size(kMagic);
+  if (bytes.size() <= pos || !std::equal(std::begin(kMagic), std::end(kMagic),
+                                         bytes.begin()) ||
+      bytes[pos++] != kFormatVersion) {
+    return false;
+  }
+
+  uint64_t header[5];
+  for (uint64_t &field : header) {
+    if (!DecodeVarint(bytes, pos, field)) {
+      return false;
+    }
+  }
+  constexpr uint64_t kMaxSide = std::numeric_limits<int>::max();
+  if (header[0] == 0 || header[0] > kMaxSide || header[1] == 0 ||
+      header[1] > kMaxSide ||
+      header[2] > std::numeric_limits<uint32_t>::max() ||
+      header[3] > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+    return false;
+  }
+
+  // Walk the inputs once so a truncated stream is rejected up front
+  std::size_t inputs_begin = pos;
+  int64_t tick = 0;
+  for (uint64_t i = 0; i < header[4]; ++i) {
+    uint64_t value = 0;
+    if (!DecodeVarint(bytes, pos, value)) {
+      return false;
+    }
+    tick += static_cast<int64_t>(value >> kActionBits);
+  }
+  if (pos != bytes.size() || tick > static_cast<int64_t>(header[3])) {
+    return false;
+  }
+
+  width_ = static_cast<int>(header[0]);
+  height_ = static_cast<int>(header[1]);
+  seed_ = static_cast<uint32_t>(header[2]);
+  end_tick_ = static_cast<int64_t>(header[3]);
+  input_count_ = header[4];
+  last_tick_ = tick;
+  inputs_.assign(bytes.begin() + inputs_begin, bytes.end());
+  return true;
+}
+
+bool SnakeReplay::SaveToFile(const std::filesystem::path &path) const {
+  std::vector<uint8_t> bytes = Serialize();
+  std::ofstream fs(path, std::ios::binary | std::ios::trunc);
+  fs.write(reinterpret_cast<const char *>(bytes.data()),
+           static_cast<std::streamsize>(bytes.size()));
+  return fs.good();
+}
+
+bool SnakeReplay::LoadFromFile(const std::filesystem::path &path) {
+  std::ifstream fs(path, std::ios::binary);
+  if (!fs.is_open()) {
+    return false;
+  }
+  std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(fs)),
+                             std::istreambuf_iterator<char>());
+  return Deserialize(bytes);
+}
+
+void SnakeReplay::EncodeVarint(uint64_t value, std::vector<uint8_t> &out) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+bool SnakeReplay::DecodeVarint(const std::vector<uint8_t> &in,
+                               std::size_t &pos, uint64_t &value) noexcept {
+  value = 0;
+  for (int shift = 0; shift < 64 && pos < in.size(); shift += 7) {
+    uint8_t byte = in[pos++];
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace s21
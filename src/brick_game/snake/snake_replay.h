@@ -0,0 +1,126 @@
+#ifndef SNAKE_REPLAY_H
+#define SNAKE_REPLAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "../common.h"
+
+namespace s21 {
+
+/**
+ * @brief A recorded snake game: the apple RNG seed plus every input the model
+ * received, indexed by simulation tick.
+ *
+ * The game is fully determined by the seed and the inputs, so replaying them
+ * into a fresh model of the same size reproduces it tick for tick. Inputs are
+ * kept in their encoded form: the tick distance to the previous input and the
+ * action are packed into one unsigned LEB128 varint, so most inputs take one
+ * or two bytes.
+ */
+class SnakeReplay {
+ public:
+  /**
+   * @brief Clears the replay and starts a new recording.
+   * @param seed The seed of the apple placement random engine.
+   * @param width The number of columns of the recorded field.
+   * @param height The number of rows of the recorded field.
+   */
+  void Reset(uint32_t seed, int width, int height);
+
+  /**
+   * @brief Appends an input received after @p tick ticks were simulated.
+   *
+   * Ticks must not decrease between two calls.
+   */
+  void Append(int64_t tick, UserAction_t action);
+
+  /**
+   * @brief Records the number of ticks simulated so far.
+   */
+  void SetEndTick(int64_t tick) noexcept { end_tick_ = tick; }
+
+  uint32_t GetSeed() const noexcept { return seed_; }
+  int GetWidth() const noexcept { return width_; }
+  int GetHeight() const noexcept { return height_; }
+  int64_t GetEndTick() const noexcept { return end_tick_; }
+  std::size_t GetInputCount() const noexcept { return input_count_; }
+
+  /**
+   * @brief Returns the encoded input stream.
+   */
+  const std::vector<uint8_t> &GetInputBytes() const noexcept {
+    return inputs_;
+  }
+
+  /**
+   * @brief Decodes the inputs in order and calls @p callback with the tick
+   * and the action of each one.
+   */
+  template <class Callback>
+  void ForEach(Callback callback) const {
+    int64_t tick = 0;
+    std::size_t pos = 0;
+    for (std::size_t i = 0; i < input_count_; ++i) {
+      uint64_t value = 0;
+      DecodeVarint(inputs_, pos, value);
+      tick += static_cast<int64_t>(value >> kActionBits);
+      callback(tick, static_cast<UserAction_t>(value & kActionMask));
+    }
+  }
+
+  /**
+   * @brief Returns the replay in its binary file format.
+   */
+  std::vector<uint8_t> Serialize() const;
+
+  /**
+   * @brief Replaces this replay with the one encoded in @p bytes.
+   *
+   * The header must describe a non-empty field and a seed that fits in 32
+   * bits, and no input may come after the end tick. Whether the field size
+   * matches a model is up to the player, see BasicSnakeReplayPlayer::Run().
+   *
+   * @return false if @p bytes is not a valid replay; the replay is left
+   * unchanged then.
+   */
+  bool Deserialize(const std::vector<uint8_t> &bytes);
+
+  /**
+   * @brief Writes the replay to a file.
+   * @return false if the file could not be written.
+   */
+  bool SaveToFile(const std::filesystem::path &path) const;
+
+  /**
+   * @brief Reads a replay written by `SaveToFile()`.
+   * @return false if the file is missing or not a valid replay.
+   */
+  bool LoadFromFile(const std::filesystem::path &path);
+
+ private:
+  static constexpr int kActionBits = 3;
+  static constexpr uint64_t kActionMask = (1u << kActionBits) - 1;
+  // Every value of the action bits decodes to a UserAction_t, so decoded
+  // inputs need no range check
+  static_assert(Action == kActionMask,
+                "the action bits must hold exactly the UserAction_t values");
+
+  static void EncodeVarint(uint64_t value, std::vector<uint8_t> &out);
+  static bool DecodeVarint(const std::vector<uint8_t> &in, std::size_t &pos,
+                           uint64_t &value) noexcept;
+
+  uint32_t seed_ = 0;
+  int width_ = 0;
+  int height_ = 0;
+  int64_t last_tick_ = 0;
+  int64_t end_tick_ = 0;
+  std::size_t input_count_ = 0;
+  std::vector<uint8_t> inputs_;
+};
+
+}  // namespace s21
+
+#endif  // SNAKE_REPLAY_H
@@ -0,0 +1,33 @@
+#include "snake_replay_player.h"
+
+namespace s21 {
+
+template <int Width, int Height>
+BasicSnakeReplayPlayer<Width, Height>::BasicSnakeReplayPlayer(
+    const SnakeReplay &replay)
+    : replay_(replay),
+      clock_(std::chrono::milliseconds(kTickInMs)),
+      model_("", &clock_, replay.GetSeed()) {}
+
+template <int Width, int Height>
+bool BasicSnakeReplayPlayer<Width, Height>::Run() noexcept {
+  if (replay_.GetWidth() != Width || replay_.GetHeight() != Height) {
+    return false;
+  }
+  replay_.ForEach([this](int64_t tick, UserAction_t action) {
+    while (model_.GetTick() < tick) {
+      model_.Tick();
+    }
+    model_.FSM(action);
+  });
+  while (model_.GetTick() < replay_.GetEndTick()) {
+    model_.Tick();
+  }
+  return true;
+}
+
+template class BasicSnakeReplayPlayer<kFieldWidth, kFieldHeight>;
+template class BasicSnakeReplayPlayer<10, 40>;
+template class BasicSnakeReplayPlayer<32, 32>;
+
+}  // namespace s21
@@ -0,0 +1,54 @@
+#ifndef SNAKE_REPLAY_PLAYER_H
+#define SNAKE_REPLAY_PLAYER_H
+
+#include "../game_clock.h"
+#include "snake_model.h"
+#include "snake_replay.h"
+
+namespace s21 {
+
+/**
+ * @brief Re-simulates a recorded game at maximum speed.
+ *
+ * The player builds a fresh model from the replay's seed and feeds it the
+ * recorded inputs at their ticks, so the game ends in exactly the state it
+ * was recorded in. The model runs on a private manual clock and is never
+ * rendered while the replay plays, which makes playback bound only by the
+ * simulation itself.
+ */
+template <int Width, int Height>
+class BasicSnakeReplayPlayer {
+ public:
+  using Model = BasicSnakeModel<Width, Height>;
+
+  /**
+   * @brief Prepares the playback of @p replay, which must outlive the player.
+   */
+  explicit BasicSnakeReplayPlayer(const SnakeReplay &replay);
+
+  /**
+   * @brief Plays the whole replay. Call it once per player.
+   * @return false if the replay was recorded on a field of another size.
+   */
+  bool Run() noexcept;
+
+  /**
+   * @brief Returns the model the replay is played into.
+   */
+  const Model &GetModel() const noexcept { return model_; }
+
+ private:
+  const SnakeReplay &replay_;
+  ManualGameClock clock_;
+  Model model_;
+};
+
+using SnakeReplayPlayer = BasicSnakeReplayPlayer<kFieldWidth, kFieldHeight>;
+
+extern template class BasicSnakeReplayPlayer<kFieldWidth, kFieldHeight>;
+extern template class BasicSnakeReplayPlayer<10, 40>;
+extern template class BasicSnakeReplayPlayer<32, 32>;
+
+}  // namespace s21
+
+#endif  // SNAKE_REPLAY_PLAYER_H
@@ -1,6 +1,16 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#include "../game_loop.h"
+#include "../input_queue.h"
+#include "../snake/snake_autopilot.h"
+#include "../snake/snake_controller.h"
 #include "../snake/snake_model.h"
+#include "../snake/snake_replay_player.h"
+#include "../work_stealing_pool.h"
 
 namespace s21 {
 
@@ -16,7 +26,6 @@ class SnakeModelTest : public ::testing::Test {
   void TearDown() override {
     // Code here will be called immediately after each test (right before the
     // destructor).
-    model->instance = nullptr;
     delete model;
   }
 
@@ -47,15 +56,15 @@ TEST_F(SnakeModelTest, UpdateCurrentState) {
   model->speed_ = 2;
   model->game_state_ = GameState::kRunning;
   model->UpdateCurrentState();
-  EXPECT_EQ(model->game_info.field[0][0], 1);
-  EXPECT_EQ(model->game_info.field[0][1], 1);
-  EXPECT_EQ(model->game_info.field[0][2], 1);
-  EXPECT_EQ(model->game_info.field[1][1], 2);
-  EXPECT_EQ(model->game_info.score, 123);
-  EXPECT_EQ(model->game_info.high_score, 666);
-  EXPECT_EQ(model->game_info.level, 3);
-  EXPECT_EQ(model->game_info.speed, 2);
-  EXPECT_EQ(model->game_info.pause, false);
+  EXPECT_EQ(model->game_info_.field[0][0], 1);
+  EXPECT_EQ(model->game_info_.field[0][1], 1);
+  EXPECT_EQ(model->game_info_.field[0][2], 1);
+  EXPECT_EQ(model->game_info_.field[1][1], 2);
+  EXPECT_EQ(model->game_info_.score, 123);
+  EXPECT_EQ(model->game_info_.high_score, 666);
+  EXPECT_EQ(model->game_info_.level, 3);
+  EXPECT_EQ(model->game_info_.speed, 2);
+  EXPECT_EQ(model->game_info_.pause, false);
 }
 
 TEST_F(SnakeModelTest, UpdateDirection) {
@@ -84,6 +93,7 @@ TEST_F(SnakeModelTest, UpdateDirection) {
 
 TEST_F(SnakeModelTest, CheckCollision) {
   model->snake_ = {{0, 0}, {0, 1}, {0, 2}};
+  model->RebuildOccupancy();
   model->apple_ = {1, 2};
   Cell nextHead = {0, 3};
   EXPECT_EQ(model->CheckCollision(nextHead), CollisionType::kNone);
@@ -137,11 +147,17 @@ TEST_F(SnakeModelTest, FSMStateTransitions) {
 }
 
 TEST_F(SnakeModelTest, CheckWinGame) {
-  // fill mock snake with 199 cells
+  // fill mock snake with 199 cells: every cell except the apple at {0, 0}
   model->snake_.clear();
-  for (int i = 1; i < 200; i++) {
-      model->snake_.emplace_back(i, 0);
+  for (int i = 1; i < kFieldHeight; i++) {
+    model->snake_.emplace_back(i, 0);
+  }
+  for (int j = 1; j < kFieldWidth; j++) {
+    for (int i = 0; i < kFieldHeight; i++) {
+      model->snake_.emplace_back(i, j);
     }
+  }
+  model->RebuildOccupancy();
   std::pair<int,int> snake_head = model->snake_.front();
   EXPECT_EQ(snake_head.first, 1);
   EXPECT_EQ(snake_head.second, 0);
@@ -155,6 +171,386 @@ TEST_F(SnakeModelTest, CheckWinGame) {
   EXPECT_EQ(model->level_, kWin);
 }
 
+TEST_F(SnakeModelTest, OccupancyFollowsSnake) {
+  EXPECT_EQ(model->occupancy_.count(), model->snake_.size());
+  model->apple_ = {0, 0};
+  model->FSM(UserAction_t::Start);
+  auto tail = model->snake_.back();
+  model->MoveOneStepForward();
+  auto head = model->snake_.front();
+  EXPECT_TRUE(model->occupancy_.test(CellIndex(head)));
+  EXPECT_FALSE(model->occupancy_.test(CellIndex(tail)));
+  EXPECT_EQ(model->occupancy_.count(), model->snake_.size());
+  EXPECT_EQ(model->CheckCollision(model->snake_.back()), CollisionType::kSnake);
+}
+
+TEST_F(SnakeModelTest, FreeCellsFollowSnake) {
+  EXPECT_EQ(model->free_count_ + model->snake_.size(), kFieldCellCount);
+  model->apple_ = {0, 0};
+  model->FSM(UserAction_t::Start);
+  model->MoveOneStepForward();
+  EXPECT_EQ(model->free_count_ + model->snake_.size(), kFieldCellCount);
+  for (int slot = 0; slot < model->free_count_; ++slot) {
+    int idx = model->free_cells_[slot];
+    EXPECT_FALSE(model->occupancy_.test(idx));
+    EXPECT_EQ(model->free_slot_[idx], slot);
+  }
+}
+
+TEST_F(SnakeModelTest, GenerateApple) {
+  for (int i = 0; i < 1000; ++i) {
+    model->GenerateApple();
+    EXPECT_EQ(model->CheckCollision(model->apple_), CollisionType::kApple);
+  }
+
+  model->snake_.clear();
+  for (int i = 0; i < kFieldHeight; i++) {
+    for (int j = 0; j < kFieldWidth; j++) {
+      model->snake_.emplace_back(i, j);
+    }
+  }
+  model->RebuildOccupancy();
+  model->GenerateApple();
+  EXPECT_EQ(model->game_state_, GameState::kGameOver);
+  EXPECT_EQ(model->level_, kWin);
+}
+
+TEST_F(SnakeModelTest, TickDrivesAutomove) {
+  model->apple_ = {0, 0};
+  model->Tick();
+  model->FSM(UserAction_t::Start);
+  auto head = model->snake_.front();
+  // The first automove comes one delay after start, the next ones also wait
+  // for the move cooldown.
+  for (int i = 1; i < model->MoveDelayInTicks(); ++i) {
+    model->Tick();
+  }
+  EXPECT_EQ(model->snake_.front(), head);
+  model->Tick();
+  EXPECT_EQ(model->snake_.front(), Cell(head.first - 1, head.second));
+  for (int i = 1; i < kMoveCooldownInTicks + model->MoveDelayInTicks(); ++i) {
+    model->Tick();
+  }
+  EXPECT_EQ(model->snake_.front(), Cell(head.first - 1, head.second));
+  model->Tick();
+  EXPECT_EQ(model->snake_.front(), Cell(head.first - 2, head.second));
+}
+
+TEST(FixedTimestepTest, CountsWholeTicksOfManualClock) {
+  ManualGameClock clock{std::chrono::milliseconds(kTickInMs)};
+  FixedTimestep timestep(&clock, std::chrono::milliseconds(kTickInMs),
+                         kMaxCatchUpTicks);
+  EXPECT_EQ(timestep.Consume(), 0);
+  clock.Step(3);
+  EXPECT_EQ(timestep.Consume(), 3);
+  clock.Advance(std::chrono::milliseconds(kTickInMs / 2));
+  EXPECT_EQ(timestep.Consume(), 0);
+  clock.Advance(std::chrono::milliseconds(kTickInMs / 2 + 1));
+  EXPECT_EQ(timestep.Consume(), 1);
+  clock.Step(kMaxCatchUpTicks * 10);
+  EXPECT_EQ(timestep.Consume(), kMaxCatchUpTicks);
+  EXPECT_EQ(timestep.Consume(), 0);
+}
+
+TEST_F(SnakeModelTest, InstancesAreIndependent) {
+  s21::SnakeModel other(".");
+  model->FSM(UserAction_t::Start);
+  model->MoveOneStepForward();
+  model->UpdateCurrentState();
+  other.UpdateCurrentState();
+
+  EXPECT_NE(model->game_info_.field, other.game_info_.field);
+  EXPECT_NE(model->snake_.front(), other.snake_.front());
+  EXPECT_EQ(other.game_state_, GameState::kStart);
+  auto [row, col] = other.snake_.front();
+  EXPECT_EQ(other.GetGameInfo().field[row][col],
+            static_cast<int>(Colors::kGreen));
+}
+
+TEST(SnakeAutopilotTest, WinsSeededGames) {
+  for (uint32_t seed = 1; seed <= 5; ++seed) {
+    s21::SnakeModel model("", nullptr, seed);
+    s21::SnakeAutopilot autopilot(&model);
+    autopilot.processUserInput(UserAction_t::Start, false);
+    autopilot.processUserInput(UserAction_t::Left, false);
+    while (model.GetGameState() == GameState::kRunning) {
+      model.Tick();
+    }
+    EXPECT_EQ(model.GetLevel(), kWin);
+    EXPECT_EQ(model.GetLength(), kSnakeSizeToWin);
+  }
+}
+
+TEST(SnakeBodyTest, WrapsAroundFixedStorage) {
+  SnakeBody<4> body;
+  body = {{0, 0}, {0, 1}, {0, 2}};
+  for (int8_t col = 3; col < 10; ++col) {
+    body.push_front({1, col});
+    body.pop_back();
+  }
+  EXPECT_EQ(body.size(), 3);
+  EXPECT_EQ(body.front(), Cell(1, 9));
+  EXPECT_EQ(body.back(), Cell(1, 7));
+
+  std::vector<Cell> cells;
+  body.ForEach([&cells](Cell cell) { cells.push_back(cell); });
+  EXPECT_EQ(cells, (std::vector<Cell>{{1, 9}, {1, 8}, {1, 7}}));
+
+  body.push_front({2, 9});
+  EXPECT_EQ(body.size(), body.capacity());
+  EXPECT_EQ(body.back(), Cell(1, 7));
+}
+
+TEST(SnakeModelSizeTest, TallFieldPlaysToWin) {
+  TallSnakeModel model("", nullptr, 7);
+  EXPECT_EQ(model.GetHead(), Cell(18, 5));
+  EXPECT_TRUE(TallSnakeModel::Contains(Cell(39, 9)));
+  EXPECT_FALSE(TallSnakeModel::Contains(Cell(40, 0)));
+
+  BasicAutopilotPolicy<10, 40> pilot;
+  model.SetPilot(&pilot);
+  model.FSM(UserAction_t::Start);
+  while (model.GetGameState() == GameState::kRunning) {
+    model.Tick();
+  }
+  EXPECT_EQ(model.GetLevel(), kWin);
+  EXPECT_EQ(model.GetLength(), TallSnakeModel::kSizeToWin);
+
+  model.UpdateCurrentState();
+  EXPECT_EQ(model.GetGameInfo().field[39][9],
+            static_cast<int>(Colors::kGreen));
+}
+
+TEST(SnakeReplayTest, PlaybackReproducesRecordedGame) {
+  SnakeModel model("", nullptr, 42);
+  GreedyPolicy pilot;
+  SnakeReplay recorded;
+  model.SetRecorder(&recorded);
+  model.SetPilot(&pilot);
+  model.FSM(UserAction_t::Start);
+  for (int i = 0; i < 100; ++i) {
+    model.Tick();
+  }
+  model.FSM(UserAction_t::Pause);
+  model.Tick();
+  model.FSM(UserAction_t::Pause);
+  while (model.GetGameState() == GameState::kRunning) {
+    model.Tick();
+  }
+
+  EXPECT_EQ(recorded.GetSeed(), 42u);
+  EXPECT_EQ(recorded.GetEndTick(), model.GetTick());
+  EXPECT_LE(recorded.GetInputBytes().size(), 2 * recorded.GetInputCount());
+
+  std::vector<uint8_t> bytes = recorded.Serialize();
+  SnakeReplay loaded;
+  EXPECT_FALSE(loaded.Deserialize(
+      std::vector<uint8_t>(bytes.begin(), bytes.end() - 1)));
+  ASSERT_TRUE(loaded.Deserialize(bytes));
+
+  SnakeReplayPlayer player(loaded);
+  ASSERT_TRUE(player.Run());
+  const SnakeModel &replayed = player.GetModel();
+  EXPECT_EQ(replayed.GetTick(), model.GetTick());
+  EXPECT_EQ(replayed.GetGameState(), GameState::kGameOver);
+  EXPECT_EQ(replayed.GetScore(), model.GetScore());
+  EXPECT_EQ(replayed.GetHead(), model.GetHead());
+  EXPECT_EQ(replayed.GetApple(), model.GetApple());
+  EXPECT_EQ(replayed.GetOccupancy(), model.GetOccupancy());
+
+  BasicSnakeReplayPlayer<10, 40> wrong_size(loaded);
+  EXPECT_FALSE(wrong_size.Run());
+}
+
+TEST(SnakeReplayTest, RejectsInvalidHeader) {
+  SnakeReplay replay;
+  replay.Reset(7, 0, kFieldHeight);
+  SnakeReplay loaded;
+  EXPECT_FALSE(loaded.Deserialize(replay.Serialize()));
+
+  // An input after the end tick
+  replay.Reset(7, kFieldWidth, kFieldHeight);
+  replay.Append(10, UserAction_t::Start);
+  replay.SetEndTick(5);
+  EXPECT_FALSE(loaded.Deserialize(replay.Serialize()));
+  replay.SetEndTick(10);
+  ASSERT_TRUE(loaded.Deserialize(replay.Serialize()));
+  EXPECT_EQ(loaded.GetWidth(), kFieldWidth);
+  EXPECT_EQ(loaded.GetHeight(), kFieldHeight);
+  EXPECT_EQ(loaded.GetEndTick(), 10);
+}
+
+TEST(HighScoreWriterTest, CoalescesAndPersistsLastScore) {
+  std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "s21_high_score_writer.txt";
+  std::filesystem::remove(path);
+  {
+    HighScoreWriter writer(path, std::chrono::hours(1));
+    for (int score = 1; score <= 100; ++score) {
+      writer.Submit(score);
+    }
+  }
+  int stored = 0;
+  std::ifstream(path) >> stored;
+  EXPECT_EQ(stored, 100);
+  EXPECT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+  std::filesystem::remove(path);
+}
+
+TEST(SpscQueueTest, RejectsPushWhenFull) {
+  SpscQueue<int, 4> queue;
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.TryPush(i));
+  }
+  EXPECT_FALSE(queue.TryPush(4));
+  int value = -1;
+  EXPECT_TRUE(queue.TryPop(value));
+  EXPECT_EQ(value, 0);
+  EXPECT_TRUE(queue.TryPush(4));
+  for (int i = 1; i <= 4; ++i) {
+    EXPECT_TRUE(queue.TryPop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(queue.TryPop(value));
+}
+
+TEST(SpscQueueTest, KeepsOrderAcrossThreads) {
+  constexpr int kCount = 200000;
+  SpscQueue<int, 64> queue;
+  std::thread producer([&queue] {
+    for (int i = 0; i < kCount;) {
+      if (queue.TryPush(i)) {
+        ++i;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+  int expected = 0;
+  bool in_order = true;
+  while (expected < kCount) {
+    int value;
+    if (queue.TryPop(value)) {
+      in_order = in_order && value == expected;
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(in_order);
+}
+
+TEST(TripleBufferTest, ReaderSeesOnlyPublishedValues) {
+  TripleBuffer<int> buffer;
+  buffer.Back() = 1;
+  buffer.Publish();
+  buffer.Back() = 2;
+  EXPECT_EQ(buffer.Front(), 1);
+  buffer.Publish();
+  buffer.Back() = 3;
+  buffer.Publish();
+  EXPECT_EQ(buffer.Front(), 3);
+  EXPECT_EQ(buffer.Front(), 3);
+}
+
+TEST(GameLoopTest, AppliesInputOnSimulationThread) {
+  SnakeModel model(".");
+  SnakeController controller(&model);
+  GameLoop loop(&controller, std::chrono::milliseconds(1));
+  EXPECT_EQ(loop.Frame().level, kStart);
+  EXPECT_EQ(loop.Frame().has_next, 0);
+
+  ASSERT_TRUE(loop.PushInput(UserAction_t::Start, false));
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (loop.Frame().level == kStart &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  const GameSnapshot &frame = loop.Frame();
+  EXPECT_GT(frame.level, 0);
+  int snake_cells = 0;
+  for (int row = 0; row < kFieldHeight; ++row) {
+    for (int col = 0; col < kFieldWidth; ++col) {
+      snake_cells += frame.field[row][col] == static_cast<int>(Colors::kGreen);
+    }
+  }
+  EXPECT_GT(snake_cells, 0);
+}
+
+TEST(GameSnapshotTest, MarksChangedRowsAndFeedsLegacyAdapter) {
+  SnakeModel model(".");
+  model.UpdateCurrentState();
+  GameSnapshot snapshot = {};
+  CaptureSnapshot(model.GetGameInfo(), snapshot);
+  EXPECT_EQ(snapshot.sequence, 1u);
+  EXPECT_NE(snapshot.dirty_rows, 0u);
+  CaptureSnapshot(model.GetGameInfo(), snapshot);
+  EXPECT_EQ(snapshot.sequence, 2u);
+  EXPECT_EQ(snapshot.dirty_rows, 0u);
+
+  GameSnapshot copy;
+  CopySnapshot(snapshot, copy);
+  LegacyGameInfo legacy;
+  const GameInfo_t& info = legacy.Update(copy);
+  EXPECT_EQ(info.next, nullptr);
+  for (int row = 0; row < kFieldHeight; ++row) {
+    for (int col = 0; col < kFieldWidth; ++col) {
+      EXPECT_EQ(info.field[row][col], model.GetGameInfo().field[row][col]);
+    }
+  }
+}
+
+TEST(SnakeCellDiffTest, ListsOnlyCellsTheSnakeMoved) {
+  ManualGameClock clock{std::chrono::milliseconds(kTickInMs)};
+  SnakeModel model("", &clock, 1);
+  model.UpdateCurrentState();
+  GameSnapshot snapshot = {};
+  CaptureSnapshot(model.GetGameInfo(), snapshot);
+
+  model.FSM(UserAction_t::Start);
+  Cell tail = model.GetTail();
+  model.FSM(UserAction_t::Action);
+  ASSERT_NE(model.GetHead(), model.GetApple());
+  model.UpdateCurrentState();
+  const auto& diff = model.GetCellDiff();
+  ASSERT_EQ(diff.count, 2);
+  for (const CellChange& change : diff) {
+    Cell cell(change.row, change.col);
+    if (cell == tail) {
+      EXPECT_EQ(change.color, 0);
+    } else {
+      EXPECT_EQ(cell, model.GetHead());
+      EXPECT_EQ(change.color, static_cast<int>(Colors::kGreen));
+    }
+  }
+
+  GameSnapshot full = snapshot;
+  CaptureSnapshot(model.GetGameInfo(), full);
+  CaptureSnapshot(model.GetGameInfo(), diff, snapshot);
+  EXPECT_EQ(std::memcmp(snapshot.field, full.field, sizeof(full.field)), 0);
+  EXPECT_EQ(snapshot.dirty_rows, full.dirty_rows);
+
+  model.UpdateCurrentState();
+  EXPECT_EQ(model.GetCellDiff().count, 0);
+}
+
+TEST(WorkStealingPoolTest, WaitsForTasksSubmittedByWorkers) {
+  std::atomic<int> finished{0};
+  {
+    WorkStealingPool pool(4);
+    for (int i = 0; i < 100; ++i) {
+      pool.Submit([&pool, &finished] {
+        pool.Submit([&finished] { finished++; });
+        finished++;
+      });
+    }
+    pool.Wait();
+    EXPECT_EQ(finished.load(), 200);
+  }
+  EXPECT_EQ(finished.load(), 200);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,845 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "../game_clock.h"
+#include "../tetris/fsm.h"
+#include "../tetris/tetris_backend.h"
+#include "../tetris/tetris_controller.h"
+#include "../tetris/tetris_game_info_t_raii.h"
+#include "../tetris/tetris_search.h"
+#include "../tetris/tetris_snapshot.h"
+
+namespace {
+
+constexpr uint8_t kPieceI = 0;
+constexpr uint8_t kPieceT = 3;
+constexpr uint8_t kPieceL = 4;
+constexpr uint8_t kPieceJ = 5;
+constexpr uint8_t kPieceO = 6;
+
+tetramino_t MakeTetramino(uint8_t piece, int rotation, int row, int col) {
+  tetramino_t tetramino = {};
+  tetramino.piece = piece;
+  tetramino.rotation = rotation;
+  tetramino.row_pos = row;
+  tetramino.col_pos = col;
+  return tetramino;
+}
+
+/**
+ * @brief Fills one cell in both the color grid and the row masks.
+ */
+template <class Board>
+void FillCell(Board &board, int row, int col, int color = kColorRed) {
+  board.board[row][col] = color;
+  board.rows[row] |= static_cast<typename Board::row_mask_t>(1u << col);
+}
+
+/**
+ * @brief The cell-by-cell check the row masks replaced: a piece fits when
+ * every sprite cell is on the board and empty.
+ */
+template <class Board>
+bool SpriteFits(const Board &board, const tetramino_t &tetramino) {
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      if (!(tetramino_figure(&tetramino)->row_mask[tetramino.rotation][i] &
+            (1u << j)))
+        continue;
+      int row = tetramino.row_pos + i;
+      int col = tetramino.col_pos + j;
+      if (row < 0 || row >= Board::kRows || col < 0 || col >= Board::kCols ||
+          board.board[row][col] != kColorBlack)
+        return false;
+    }
+  }
+  return true;
+}
+
+template <class Board>
+bool MaskFits(const Board &board, const tetramino_t &tetramino) {
+  return !check_lborder_collide(&tetramino) &&
+         !check_rborder_collide<Board::kCols>(&tetramino) &&
+         !check_board_collide(&tetramino, &board);
+}
+
+/**
+ * @brief Compares the mask checks with the cell scan for every piece and
+ * rotation at every position around a randomly filled bottom half.
+ */
+template <class Board>
+void ExpectMasksMatchCells() {
+  Board board = {};
+  init_board(&board);
+  std::mt19937 rng(7);
+  for (int row = Board::kRows / 2; row < Board::kRows; ++row)
+    for (int col = 0; col < Board::kCols; ++col)
+      if (rng() % 2 == 0) FillCell(board, row, col);
+
+  for (uint8_t piece = 0; piece < TETRAMINOS; ++piece) {
+    tetramino_t tetramino = MakeTetramino(piece, 0, 0, 0);
+    for (int rotation = 0;
+         rotation <= tetramino_figure(&tetramino)->max_rotation; ++rotation) {
+      tetramino.rotation = rotation;
+      for (int row = -2; row <= Board::kRows; ++row) {
+        for (int col = -3; col <= Board::kCols; ++col) {
+          tetramino.row_pos = row;
+          tetramino.col_pos = col;
+          ASSERT_EQ(MaskFits(board, tetramino), SpriteFits(board, tetramino))
+              << "piece " << int(piece) << " rotation " << rotation << " at "
+              << row << "," << col;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief The column heights and holes, scanned from the row masks.
+ */
+template <class Board>
+void ScanColumns(const Board &board, uint8_t (&heights)[Board::kCols],
+                 uint8_t (&holes)[Board::kCols]) {
+  for (int col = 0; col < Board::kCols; ++col) {
+    heights[col] = 0;
+    holes[col] = 0;
+    for (int row = 0; row < Board::kRows; ++row) {
+      bool filled = (board.rows[row] >> col) & 1u;
+      if (filled && heights[col] == 0) heights[col] = Board::kRows - row;
+      if (!filled && heights[col] != 0) ++holes[col];
+    }
+  }
+}
+
+/**
+ * @brief Rebuilds the column cache of a board filled cell by cell.
+ */
+template <class Board>
+void SyncColumns(Board &board) {
+  ScanColumns(board, board.heights, board.holes);
+}
+
+template <class Board>
+void ExpectColumnsMatchRows(const Board &board) {
+  uint8_t heights[Board::kCols];
+  uint8_t holes[Board::kCols];
+  ScanColumns(board, heights, holes);
+  for (int col = 0; col < Board::kCols; ++col) {
+    EXPECT_EQ(board.heights[col], heights[col]) << "column " << col;
+    EXPECT_EQ(board.holes[col], holes[col]) << "column " << col;
+  }
+}
+
+/**
+ * @brief A piece where gen_next_tetramino() deals it on a board_t.
+ */
+tetramino_t Spawned(uint8_t piece) {
+  return MakeTetramino(piece, 0, 0, BOARD_COLS / 2 - 2);
+}
+
+/**
+ * @brief Whether two pieces fill the same board cells, whatever rotation
+ * they are in.
+ */
+bool SameCells(const tetramino_t &a, const tetramino_t &b) {
+  uint64_t cells_a[BOARD_ROWS + 4] = {};
+  uint64_t cells_b[BOARD_ROWS + 4] = {};
+  for (int i = 0; i < 4; ++i) {
+    cells_a[a.row_pos + 2 + i] =
+        uint64_t{tetramino_figure(&a)->row_mask[a.rotation][i]}
+        << (a.col_pos + MASK_COL_OFFSET);
+    cells_b[b.row_pos + 2 + i] =
+        uint64_t{tetramino_figure(&b)->row_mask[b.rotation][i]}
+        << (b.col_pos + MASK_COL_OFFSET);
+  }
+  return std::equal(std::begin(cells_a), std::end(cells_a),
+                    std::begin(cells_b));
+}
+
+void ExpectSamePosition(const tetramino_t &actual,
+                        const tetramino_t &expected) {
+  EXPECT_EQ(actual.piece, expected.piece);
+  EXPECT_EQ(actual.rotation, expected.rotation);
+  EXPECT_EQ(actual.row_pos, expected.row_pos);
+  EXPECT_EQ(actual.col_pos, expected.col_pos);
+}
+
+}  // namespace
+
+TEST(TetrisCollisionTest, LeftBorderWithNegativeColumn) {
+  // The vertical I fills sprite column 2, so it still fits at col_pos -2
+  tetramino_t vertical_i = MakeTetramino(kPieceI, 1, 0, -2);
+  EXPECT_FALSE(check_lborder_collide(&vertical_i));
+  vertical_i.col_pos = -3;
+  EXPECT_TRUE(check_lborder_collide(&vertical_i));
+
+  tetramino_t o = MakeTetramino(kPieceO, 0, 0, -1);
+  EXPECT_FALSE(check_lborder_collide(&o));
+  o.col_pos = -2;
+  EXPECT_TRUE(check_lborder_collide(&o));
+}
+
+TEST(TetrisCollisionTest, RightBorder) {
+  tetramino_t vertical_i = MakeTetramino(kPieceI, 1, 0, BOARD_COLS - 3);
+  EXPECT_FALSE(check_rborder_collide(&vertical_i));
+  vertical_i.col_pos++;
+  EXPECT_TRUE(check_rborder_collide(&vertical_i));
+
+  tetramino_t o = MakeTetramino(kPieceO, 0, 0, square_board_t::kCols - 3);
+  EXPECT_FALSE(check_rborder_collide<square_board_t::kCols>(&o));
+  o.col_pos++;
+  EXPECT_TRUE(check_rborder_collide<square_board_t::kCols>(&o));
+}
+
+TEST(TetrisCollisionTest, FloorTopAndFilledCells) {
+  board_t board = {};
+  init_board(&board);
+  // The flat I fills sprite row 1
+  tetramino_t flat_i = MakeTetramino(kPieceI, 0, BOARD_ROWS - 2, 0);
+  EXPECT_FALSE(check_board_collide(&flat_i, &board));
+  flat_i.row_pos++;
+  EXPECT_TRUE(check_board_collide(&flat_i, &board));
+  flat_i.row_pos = -1;
+  EXPECT_FALSE(check_board_collide(&flat_i, &board));
+  flat_i.row_pos = -2;
+  EXPECT_TRUE(check_board_collide(&flat_i, &board));
+
+  FillCell(board, BOARD_ROWS - 1, 4);
+  flat_i.row_pos = BOARD_ROWS - 2;
+  EXPECT_FALSE(check_board_collide(&flat_i, &board));
+  flat_i.col_pos = 1;
+  EXPECT_TRUE(check_board_collide(&flat_i, &board));
+  flat_i.col_pos = 5;
+  EXPECT_FALSE(check_board_collide(&flat_i, &board));
+}
+
+TEST(TetrisCollisionTest, MasksMatchCellScanOnEveryBoardSize) {
+  ExpectMasksMatchCells<board_t>();
+  ExpectMasksMatchCells<tall_board_t>();
+  ExpectMasksMatchCells<square_board_t>();
+}
+
+TEST(TetrisCollisionTest, AttachFillsMasksAndColors) {
+  board_t board = {};
+  init_board(&board);
+  board.dirty_rows = 0;
+  board.tetramino_curr = MakeTetramino(kPieceO, 0, BOARD_ROWS - 2, -1);
+  attach_tetramino(&board);
+  EXPECT_EQ(board.rows[BOARD_ROWS - 2], 0x3);
+  EXPECT_EQ(board.rows[BOARD_ROWS - 1], 0x3);
+  EXPECT_EQ(board.board[BOARD_ROWS - 1][0], kColorYellow);
+  EXPECT_EQ(board.board[BOARD_ROWS - 1][1], kColorYellow);
+  EXPECT_EQ(board.board[BOARD_ROWS - 1][2], kColorBlack);
+  EXPECT_EQ(board.dirty_rows, 3u << (BOARD_ROWS - 2));
+}
+
+TEST(TetrisCollisionTest, EveryTableRotationHasFourCells) {
+  for (uint8_t piece = 0; piece < TETRAMINOS; ++piece) {
+    tetramino_t tetramino = MakeTetramino(piece, 0, 0, 0);
+    const figure_t *figure = tetramino_figure(&tetramino);
+    for (int rotation = 0; rotation <= figure->max_rotation; ++rotation) {
+      int cells = 0;
+      for (int i = 0; i < 4; ++i)
+        cells += __builtin_popcount(figure->row_mask[rotation][i]);
+      EXPECT_EQ(cells, 4) << "piece " << int(piece) << " rotation "
+                          << rotation;
+    }
+  }
+}
+
+/**
+ * @brief A turn expected to take one specific wall kick.
+ */
+struct KickCase {
+  tetramino_t from;
+  tetramino_t to;
+  const char *kick;
+};
+
+TEST(TetrisRotationTest, FourTurnsReturnToSpawn) {
+  board_t board = {};
+  init_board_seeded(&board, 1, RANDOMIZER_BAG7);
+  for (uint8_t piece = 0; piece < TETRAMINOS; ++piece) {
+    if (piece == kPieceO) continue;
+    const tetramino_t spawned = Spawned(piece);
+    tetramino_t turned = spawned;
+    for (int turn = 0; turn < 4; ++turn)
+      ASSERT_TRUE(rotate_tetramino(&board, &turned))
+          << "piece " << int{piece} << " turn " << turn;
+    ExpectSamePosition(turned, spawned);
+    EXPECT_TRUE(SameCells(turned, spawned));
+  }
+}
+
+TEST(TetrisRotationTest, JlstzKicksOffWallsAndFloor) {
+  board_t board = {};
+  init_board_seeded(&board, 1, RANDOMIZER_BAG7);
+  const int floor = BOARD_ROWS - 2;
+  const KickCase cases[] = {
+      {{5, -1, kPieceT, 1}, {5, 0, kPieceT, 2}, "T R->2 off the left wall"},
+      {{5, BOARD_COLS - 2, kPieceT, 3},
+       {5, BOARD_COLS - 3, kPieceT, 0},
+       "T L->0 off the right wall"},
+      {{floor, 3, kPieceT, 0},
+       {floor - 1, 2, kPieceT, 1},
+       "T 0->R off the floor"},
+      {{5, -1, kPieceJ, 1}, {5, 0, kPieceJ, 2}, "J R->2 off the left wall"},
+      {{5, BOARD_COLS - 2, kPieceJ, 3},
+       {5, BOARD_COLS - 3, kPieceJ, 0},
+       "J L->0 off the right wall"},
+      {{floor, 3, kPieceJ, 0},
+       {floor - 1, 2, kPieceJ, 1},
+       "J 0->R off the floor"},
+  };
+  for (const KickCase &kick : cases) {
+    SCOPED_TRACE(kick.kick);
+    tetramino_t turned = kick.from;
+    ASSERT_TRUE(rotate_tetramino(&board, &turned));
+    ExpectSamePosition(turned, kick.to);
+  }
+}
+
+TEST(TetrisRotationTest, IKicksUseItsOwnTable) {
+  board_t board = {};
+  init_board_seeded(&board, 1, RANDOMIZER_BAG7);
+  const KickCase wall_cases[] = {
+      {{5, -2, kPieceI, 1}, {5, 0, kPieceI, 2}, "I R->2 off the left wall"},
+      {{5, BOARD_COLS - 2, kPieceI, 3},
+       {5, BOARD_COLS - 4, kPieceI, 0},
+       "I L->0 off the right wall"},
+  };
+  for (const KickCase &kick : wall_cases) {
+    SCOPED_TRACE(kick.kick);
+    tetramino_t turned = kick.from;
+    ASSERT_TRUE(rotate_tetramino(&board, &turned));
+    ExpectSamePosition(turned, kick.to);
+  }
+
+  // The flat I lies on row 6 against the right wall; the vertical I fills
+  // sprite column 2, rows 5-8. A cell under column 8 blocks the plain turn,
+  // so 0->R kicks two columns left, or with column 6 blocked too, one right.
+  const tetramino_t flat = {5, BOARD_COLS - 4, kPieceI, 0};
+  FillCell(board, 7, BOARD_COLS - 2);
+  tetramino_t turned = flat;
+  ASSERT_TRUE(rotate_tetramino(&board, &turned));
+  ExpectSamePosition(turned, {5, BOARD_COLS - 6, kPieceI, 1});
+
+  FillCell(board, 7, BOARD_COLS - 4);
+  turned = flat;
+  ASSERT_TRUE(rotate_tetramino(&board, &turned));
+  ExpectSamePosition(turned, {5, BOARD_COLS - 3, kPieceI, 1});
+}
+
+TEST(TetrisRotationTest, BlockedTurnKeepsPieceAndState) {
+  // Every cell but the T's own is filled, so no turn or kick fits
+  board_t board = {};
+  init_board_seeded(&board, 1, RANDOMIZER_BAG7);
+  const tetramino_t t = {10, 3, kPieceT, 0};
+  for (int row = 0; row < BOARD_ROWS; ++row)
+    for (int col = 0; col < BOARD_COLS; ++col) FillCell(board, row, col);
+  const figure_t *figure = tetramino_figure(&t);
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      if (!((figure->row_mask[t.rotation][i] >> j) & 1)) continue;
+      board.board[t.row_pos + i][t.col_pos + j] = kColorBlack;
+      board.rows[t.row_pos + i] &=
+          static_cast<uint16_t>(~(1u << (t.col_pos + j)));
+    }
+  }
+  board.tetramino_curr = t;
+  game_state state = MOVING;
+  on_moving_state(ACTION_BTN, &state, &board);
+  EXPECT_EQ(state, MOVING);
+  ExpectSamePosition(board.tetramino_curr, t);
+
+  board_t empty = {};
+  init_board_seeded(&empty, 1, RANDOMIZER_BAG7);
+  const tetramino_t o = Spawned(kPieceO);
+  tetramino_t turned = o;
+  EXPECT_FALSE(rotate_tetramino(&empty, &turned));
+  ExpectSamePosition(turned, o);
+  empty.tetramino_curr = o;
+  on_moving_state(ACTION_BTN, &state, &empty);
+  EXPECT_EQ(state, MOVING);
+  ExpectSamePosition(empty.tetramino_curr, o);
+}
+
+class TetrisClearTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    init_board_seeded(&board, 1, RANDOMIZER_BAG7);
+    init_transient_stats(&stats);
+  }
+
+  /**
+   * @brief Fills columns [first, last] of @p row with @p color.
+   */
+  void FillRow(int row, int first, int last, int color) {
+    for (int col = first; col <= last; ++col) FillCell(board, row, col, color);
+  }
+
+  /**
+   * @brief Locks a vertical I in the last column, covering rows
+   * [top, top + 3], the way the state machine does.
+   */
+  void DropIntoLastColumn(int top) {
+    SyncColumns(board);
+    board.tetramino_curr = MakeTetramino(kPieceI, 1, top, BOARD_COLS - 3);
+    game_state state = ATTACHING;
+    on_attach_state(&state, &stats, &board);
+    EXPECT_EQ(state, SPAWN);
+  }
+
+  board_t board = {};
+  game_stats_t stats = {};
+};
+
+TEST_F(TetrisClearTest, ClearsRowsApartInOnePass) {
+  const int bottom = BOARD_ROWS - 1;
+  FillCell(board, bottom - 3, 0, kColorGreen);
+  FillRow(bottom - 2, 0, BOARD_COLS - 2, kColorRed);
+  FillRow(bottom - 1, 0, BOARD_COLS - 3, kColorBlue);
+  FillRow(bottom, 0, BOARD_COLS - 2, kColorRed);
+  DropIntoLastColumn(bottom - 3);
+
+  EXPECT_EQ(board.cleared_rows, (1u << bottom) | (1u << (bottom - 2)));
+  EXPECT_EQ(stats.score, SCORE_2);
+  // The partial rows moved down over the cleared ones, with their colors
+  EXPECT_EQ(board.rows[bottom], 0x2FF);
+  EXPECT_EQ(board.rows[bottom - 1], 0x201);
+  for (int row = 0; row < bottom - 1; ++row) EXPECT_EQ(board.rows[row], 0);
+  EXPECT_EQ(board.board[bottom][0], kColorBlue);
+  EXPECT_EQ(board.board[bottom][BOARD_COLS - 3], kColorBlue);
+  EXPECT_EQ(board.board[bottom][BOARD_COLS - 2], kColorBlack);
+  EXPECT_EQ(board.board[bottom][BOARD_COLS - 1], kColorCyan);
+  EXPECT_EQ(board.board[bottom - 1][0], kColorGreen);
+  EXPECT_EQ(board.board[bottom - 1][1], kColorBlack);
+  EXPECT_EQ(board.board[bottom - 1][BOARD_COLS - 1], kColorCyan);
+  for (int row = 0; row < bottom - 1; ++row)
+    for (int col = 0; col < BOARD_COLS; ++col)
+      EXPECT_EQ(board.board[row][col], kColorBlack);
+  ExpectColumnsMatchRows(board);
+}
+
+TEST_F(TetrisClearTest, ClearsFourRows) {
+  const int bottom = BOARD_ROWS - 1;
+  FillCell(board, bottom - 4, 2, kColorGreen);
+  for (int row = bottom - 3; row <= bottom; ++row)
+    FillRow(row, 0, BOARD_COLS - 2, kColorRed);
+  DropIntoLastColumn(bottom - 3);
+
+  EXPECT_EQ(board.cleared_rows, 0xFu << (bottom - 3));
+  EXPECT_EQ(stats.score, SCORE_4);
+  EXPECT_EQ(board.rows[bottom], 0x4);
+  EXPECT_EQ(board.board[bottom][2], kColorGreen);
+  for (int row = 0; row < bottom; ++row) EXPECT_EQ(board.rows[row], 0);
+  for (int col = 0; col < BOARD_COLS; ++col) {
+    if (col != 2) {
+      EXPECT_EQ(board.board[bottom][col], kColorBlack);
+    }
+  }
+  ExpectColumnsMatchRows(board);
+}
+
+TEST_F(TetrisClearTest, ClearsTheTopRow) {
+  // The old loop stopped at row 0 and left it full
+  FillRow(0, 0, BOARD_COLS - 2, kColorRed);
+  FillCell(board, 1, 0, kColorGreen);
+  DropIntoLastColumn(0);
+
+  EXPECT_EQ(board.cleared_rows, 1u);
+  EXPECT_EQ(board.rows[0], 0);
+  EXPECT_EQ(board.rows[1], 0x201);
+  EXPECT_EQ(board.rows[2], 0x200);
+  EXPECT_EQ(board.rows[3], 0x200);
+}
+
+TEST_F(TetrisClearTest, ClearsRowsOfATallBoard) {
+  tall_board_t tall = {};
+  init_board(&tall);
+  const int bottom = tall_board_t::kRows - 1;
+  for (int row = bottom - 1; row <= bottom; ++row)
+    for (int col = 0; col < tall_board_t::kCols - 1; ++col)
+      FillCell(tall, row, col);
+  tall.tetramino_curr = MakeTetramino(kPieceI, 1, bottom - 3,
+                                      tall_board_t::kCols - 3);
+  game_state state = ATTACHING;
+  on_attach_state(&state, &stats, &tall);
+
+  EXPECT_EQ(tall.cleared_rows, uint64_t{3} << (bottom - 1));
+  EXPECT_EQ(tall.rows[bottom], 0x200);
+  EXPECT_EQ(tall.rows[bottom - 1], 0x200);
+}
+
+TEST(TetrisRandomizerTest, EveryBagIsAPermutation) {
+  randomizer_t randomizer;
+  seed_randomizer(&randomizer, 42, RANDOMIZER_BAG7);
+  for (int bag = 0; bag < 100; ++bag) {
+    uint32_t dealt = 0;
+    for (int i = 0; i < TETRAMINOS; ++i) {
+      uint8_t piece = randomizer_next(&randomizer);
+      ASSERT_LT(piece, TETRAMINOS);
+      EXPECT_FALSE((dealt >> piece) & 1) << "bag " << bag << " repeats "
+                                         << int{piece};
+      dealt |= 1u << piece;
+    }
+    EXPECT_EQ(dealt, (1u << TETRAMINOS) - 1) << "bag " << bag;
+  }
+}
+
+TEST(TetrisRandomizerTest, SameSeedDealsSameSequence) {
+  for (randomizer_mode_t mode : {RANDOMIZER_UNIFORM, RANDOMIZER_BAG7}) {
+    randomizer_t first;
+    randomizer_t second;
+    randomizer_t other;
+    seed_randomizer(&first, 2024, mode);
+    seed_randomizer(&second, 2024, mode);
+    seed_randomizer(&other, 2025, mode);
+    int differences = 0;
+    for (int i = 0; i < 1000; ++i) {
+      uint8_t piece = randomizer_next(&first);
+      ASSERT_EQ(piece, randomizer_next(&second)) << "draw " << i;
+      if (piece != randomizer_next(&other)) ++differences;
+    }
+    EXPECT_GT(differences, 0);
+  }
+}
+
+TEST(TetrisRandomizerTest, LookaheadMatchesDealtPieces) {
+  board_t board = {};
+  init_board_seeded(&board, 7, RANDOMIZER_BAG7);
+  for (int spawn = 0; spawn < 100; ++spawn) {
+    uint8_t queued[PIECE_QUEUE_SIZE];
+    for (int i = 0; i < PIECE_QUEUE_SIZE; ++i)
+      queued[i] = randomizer_peek(&board.randomizer, i);
+    // The queue shifts by one per piece, so each queued piece comes out of
+    // gen_next_tetramino in order
+    randomizer_t copy = board.randomizer;
+    for (int i = 0; i < PIECE_QUEUE_SIZE; ++i)
+      EXPECT_EQ(randomizer_next(&copy), queued[i]) << "spawn " << spawn;
+    EXPECT_EQ(gen_next_tetramino(&board).piece, queued[0]);
+    for (int i = 1; i < PIECE_QUEUE_SIZE; ++i)
+      EXPECT_EQ(randomizer_peek(&board.randomizer, i - 1), queued[i]);
+  }
+}
+
+class TetrisSearchTest : public ::testing::Test {
+ protected:
+  void SetUp() override { init_board_seeded(&board, 1, RANDOMIZER_BAG7); }
+
+  /**
+   * @brief Builds an overhang over the left half of the second row from the
+   * bottom, with the bottom row left empty under it.
+   */
+  void BuildOverhang() {
+    for (int col = 0; col < kOverhang; ++col)
+      FillCell(board, BOARD_ROWS - 2, col);
+    SyncColumns(board);
+  }
+
+  static constexpr int kOverhang = 5;
+  board_t board = {};
+  placement_t placements[SEARCH_STATES];
+};
+
+TEST_F(TetrisSearchTest, EmptyBoardPlacements) {
+  const int expected[TETRAMINOS] = {17, 17, 17, 34, 34, 34, 9};
+  for (uint8_t piece = 0; piece < TETRAMINOS; ++piece) {
+    tetramino_t spawned = Spawned(piece);
+    int count = find_placements(&board, &spawned, placements);
+    EXPECT_EQ(count, expected[piece]) << "piece " << int{piece};
+    for (int i = 0; i < count; ++i)
+      EXPECT_EQ(drop_distance(&board, &placements[i].tetramino), 0);
+  }
+}
+
+TEST_F(TetrisSearchTest, FindsTuckUnderOverhang) {
+  BuildOverhang();
+  tetramino_t spawned = Spawned(kPieceI);
+  // The flat I fills sprite row 1, so this covers the bottom row cols 0-3
+  const tetramino_t tuck = MakeTetramino(kPieceI, 0, BOARD_ROWS - 2, 0);
+  int count = find_placements(&board, &spawned, placements);
+  int found = 0;
+  for (int i = 0; i < count; ++i)
+    if (SameCells(placements[i].tetramino, tuck)) ++found;
+  EXPECT_EQ(found, 1);
+
+  // No hard drop from the top, in any rotation and column, gets under the
+  // overhang
+  for (int rotation = 0; rotation <= tetramino_figure(&tuck)->max_rotation;
+       ++rotation) {
+    for (int col = -3; col < BOARD_COLS; ++col) {
+      tetramino_t dropped = MakeTetramino(kPieceI, rotation, 0, col);
+      if (check_lborder_collide(&dropped) || check_rborder_collide(&dropped))
+        continue;
+      dropped.row_pos += drop_distance(&board, &dropped);
+      EXPECT_FALSE(SameCells(dropped, tuck))
+          << "rotation " << rotation << " col " << col;
+    }
+  }
+}
+
+TEST_F(TetrisSearchTest, PlannedMovesReachEveryPlacement) {
+  BuildOverhang();
+  signals moves[SEARCH_STATES];
+  for (uint8_t piece : {kPieceI, kPieceT, kPieceL, kPieceO}) {
+    tetramino_t spawned = Spawned(piece);
+    int count = find_placements(&board, &spawned, placements);
+    ASSERT_GT(count, 0);
+    for (int i = 0; i < count; ++i) {
+      const tetramino_t &target = placements[i].tetramino;
+      int length = plan_placement_moves(&board, &spawned, &target, moves);
+      ASSERT_GE(length, 0) << "piece " << int{piece} << " placement " << i;
+
+      board.tetramino_curr = spawned;
+      game_state state = MOVING;
+      for (int move = 0; move < length; ++move) {
+        on_moving_state(moves[move], &state, &board);
+        ASSERT_EQ(state, MOVING);
+      }
+      ExpectSamePosition(board.tetramino_curr, target);
+      on_moving_state(MOVE_DOWN, &state, &board);
+      EXPECT_EQ(state, ATTACHING);
+    }
+  }
+}
+
+TEST_F(TetrisSearchTest, SearchesEveryBoardSize) {
+  tall_board_t tall = {};
+  square_board_t square = {};
+  init_board_seeded(&tall, 1, RANDOMIZER_BAG7);
+  init_board_seeded(&square, 1, RANDOMIZER_BAG7);
+  static placement_t wide[search_states<32, 32>];
+  tetramino_t spawned = Spawned(kPieceO);
+  // The O fits in every column pair, whatever the height
+  EXPECT_EQ(find_placements(&tall, &spawned, wide), tall_board_t::kCols - 1);
+  EXPECT_EQ(find_placements(&square, &spawned, wide),
+            square_board_t::kCols - 1);
+}
+
+TEST_F(TetrisClearTest, HardDropKeepsColumnCache) {
+  const int bottom = BOARD_ROWS - 1;
+  FillRow(bottom, 0, 3, kColorRed);
+  FillCell(board, bottom - 3, 1, kColorRed);
+  SyncColumns(board);
+  EXPECT_EQ(board_holes(&board), 2);
+
+  // The O over columns 0-1 lands on the floating cell, a vertical I in
+  // column 4 falls to the floor
+  tetramino_t o = Spawned(kPieceO);
+  o.col_pos = -1;
+  EXPECT_EQ(drop_distance(&board, &o), bottom - 5);
+  board.tetramino_curr = MakeTetramino(kPieceI, 1, 0, 2);
+  game_state state = MOVING;
+  on_moving_state(HARD_DROP, &state, &board);
+  EXPECT_EQ(state, ATTACHING);
+  EXPECT_EQ(board.tetramino_curr.row_pos, bottom - 3);
+  on_attach_state(&state, &stats, &board);
+  ExpectColumnsMatchRows(board);
+  EXPECT_EQ(board_holes(&board), 2);
+}
+
+class TetrisSnapshotTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    init_board_seeded(&board, 5, RANDOMIZER_BAG7);
+    init_transient_stats(&stats);
+  }
+
+  /**
+   * @brief Feeds one input signal through the state machine, first taking
+   * it through the spawn and attach states, which need no input.
+   */
+  void Send(signals sig) {
+    while (state == SPAWN || state == ATTACHING) {
+      sigact(NOSIG, &state, &stats, &board);
+      if (state == MOVING) dealt.push_back(board.tetramino_curr.piece);
+    }
+    sigact(sig, &state, &stats, &board);
+    inputs.push_back(sig);
+  }
+
+  /**
+   * @brief Moves the spawned piece to its best placement and locks it,
+   * leaving the state machine in ATTACHING.
+   */
+  void PlayPiece() {
+    Send(NOSIG);
+    ASSERT_EQ(state, MOVING);
+    placement_t best;
+    ASSERT_GT(find_best_placement(&board, &board.tetramino_curr,
+                                  weighted_heuristic,
+                                  &default_heuristic_weights, &best),
+              0);
+    signals moves[SEARCH_STATES];
+    int count = plan_placement_moves(&board, &board.tetramino_curr,
+                                     &best.tetramino, moves);
+    ASSERT_GE(count, 0);
+    for (int i = 0; i < count; ++i) Send(moves[i]);
+    Send(MOVE_DOWN);
+    ASSERT_EQ(state, ATTACHING);
+  }
+
+  /**
+   * @brief Attaches the locked piece, so the next input spawns a new one.
+   */
+  void Attach() { sigact(NOSIG, &state, &stats, &board); }
+
+  board_t board = {};
+  game_stats_t stats = {};
+  game_state state = SPAWN;
+  std::vector<signals> inputs;
+  std::vector<uint8_t> dealt;
+};
+
+TEST_F(TetrisSnapshotTest, RestoresStateAcrossLineClear) {
+  for (int piece = 0; piece < 8; ++piece) {
+    PlayPiece();
+    Attach();
+  }
+  tetris_snapshot_t snapshot;
+  tetris_colors_t colors;
+  save_snapshot(&board, &stats, state, &snapshot);
+  save_colors(&board, &colors);
+  const board_t saved = board;
+  const game_stats_t saved_stats = stats;
+  const game_state saved_state = state;
+
+  inputs.clear();
+  dealt.clear();
+  for (int piece = 0; piece < 100 && stats.score == saved_stats.score;
+       ++piece) {
+    PlayPiece();
+    Attach();
+  }
+  ASSERT_GT(stats.score, saved_stats.score) << "no row was cleared";
+  for (int piece = 0; piece < 3; ++piece) {
+    PlayPiece();
+    Attach();
+  }
+  const board_t played = board;
+  const game_stats_t played_stats = stats;
+  const std::vector<signals> played_inputs = inputs;
+  const std::vector<uint8_t> played_dealt = dealt;
+
+  board.dirty_rows = 0;
+  restore_snapshot(&snapshot, &colors, &board, &stats, &state);
+  EXPECT_EQ(state, saved_state);
+  for (int row = 0; row < BOARD_ROWS; ++row)
+    EXPECT_EQ(board.rows[row], saved.rows[row]) << "row " << row;
+  for (int col = 0; col < BOARD_COLS; ++col) {
+    EXPECT_EQ(board.heights[col], saved.heights[col]) << "column " << col;
+    EXPECT_EQ(board.holes[col], saved.holes[col]) << "column " << col;
+  }
+  EXPECT_EQ(board.cleared_rows, saved.cleared_rows);
+  ExpectSamePosition(board.tetramino_curr, saved.tetramino_curr);
+  ExpectSamePosition(board.tetramino_next, saved.tetramino_next);
+  EXPECT_EQ(std::memcmp(&board.randomizer, &saved.randomizer,
+                        sizeof(randomizer_t)),
+            0);
+  EXPECT_EQ(stats.score, saved_stats.score);
+  EXPECT_EQ(stats.high_score, saved_stats.high_score);
+  EXPECT_EQ(stats.level, saved_stats.level);
+  EXPECT_EQ(stats.next_advance_time_in_ms,
+            saved_stats.next_advance_time_in_ms);
+
+  // Every cell gets its color back, and only the rows with a changed cell
+  // are marked for repainting
+  board_t::row_set_t changed = 0;
+  for (int row = 0; row < BOARD_ROWS; ++row) {
+    for (int col = 0; col < BOARD_COLS; ++col) {
+      if (played.board[row][col] != saved.board[row][col])
+        changed |= board_t::row_set_t{1} << row;
+      EXPECT_EQ(board.board[row][col], saved.board[row][col])
+          << row << "," << col;
+    }
+  }
+  EXPECT_NE(changed, 0u);
+  EXPECT_EQ(board.dirty_rows, changed);
+
+  // The same inputs from the restored state deal the same pieces to the
+  // same board
+  inputs.clear();
+  dealt.clear();
+  for (signals sig : played_inputs) Send(sig);
+  Attach();
+  EXPECT_EQ(dealt, played_dealt);
+  for (int row = 0; row < BOARD_ROWS; ++row)
+    EXPECT_EQ(board.rows[row], played.rows[row]) << "row " << row;
+  ExpectSamePosition(board.tetramino_next, played.tetramino_next);
+  EXPECT_EQ(stats.score, played_stats.score);
+}
+
+TEST_F(TetrisSnapshotTest, RestoreWithoutColorsPaintsCellsWhite) {
+  for (int piece = 0; piece < 4; ++piece) {
+    PlayPiece();
+    Attach();
+  }
+  tetris_snapshot_t snapshot;
+  save_snapshot(&board, &stats, state, &snapshot);
+  const board_t saved = board;
+
+  // Cells the snapshot brings back are white, cells it empties are black,
+  // the others keep their color
+  PlayPiece();
+  Attach();
+  const board_t played = board;
+  board.dirty_rows = 0;
+  restore_snapshot(&snapshot, nullptr, &board, &stats, &state);
+  board_t::row_set_t changed = 0;
+  for (int row = 0; row < BOARD_ROWS; ++row) {
+    if (played.rows[row] != saved.rows[row])
+      changed |= board_t::row_set_t{1} << row;
+    for (int col = 0; col < BOARD_COLS; ++col) {
+      bool was_filled = (played.rows[row] >> col) & 1;
+      bool is_filled = (saved.rows[row] >> col) & 1;
+      int expected = kColorBlack;
+      if (is_filled)
+        expected = was_filled ? played.board[row][col] : kColorWhite;
+      EXPECT_EQ(board.board[row][col], expected) << row << "," << col;
+    }
+  }
+  EXPECT_NE(changed, 0u);
+  EXPECT_EQ(board.dirty_rows, changed);
+}
+
+TEST(TetrisControllerTest, SeveralControllersCoexist) {
+  s21::ManualGameClock clock(std::chrono::milliseconds(s21::kTetrisTickInMs));
+  GameInfo first_info;
+  GameInfo second_info;
+  board_t first_board = {};
+  board_t second_board = {};
+  init_board_seeded(&first_board, 1, RANDOMIZER_BAG7);
+  init_board_seeded(&second_board, 2, RANDOMIZER_BAG7);
+  game_stats_t first_stats;
+  game_stats_t second_stats;
+  init_transient_stats(&first_stats);
+  init_transient_stats(&second_stats);
+  game_state first_state = START;
+  game_state second_state = START;
+
+  auto first = std::make_unique<s21::TetrisController>(
+      first_info.get(), &first_state, &first_board, &first_stats, &clock);
+  s21::TetrisController second(second_info.get(), &second_state,
+                               &second_board, &second_stats, &clock);
+  EXPECT_EQ(s21::TetrisController::Bound(), first.get());
+
+  // Each controller drives only its own game
+  second.processUserInput(UserAction_t::Start, false);
+  EXPECT_EQ(second_state, SPAWN);
+  EXPECT_EQ(first_state, START);
+  userInput(UserAction_t::Start, false);
+  EXPECT_EQ(first_state, SPAWN);
+
+  // The bridge is released with the controller bound to it
+  first.reset();
+  EXPECT_EQ(s21::TetrisController::Bound(), nullptr);
+  userInput(UserAction_t::Terminate, false);
+  EXPECT_EQ(second_state, SPAWN);
+}
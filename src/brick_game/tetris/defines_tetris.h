@@ -21,9 +21,17 @@
 #define LEVEL_CNT 10
 
 #define TETRAMINOS 7
+/* Number of upcoming pieces each board knows in advance after the next one */
+#define PIECE_QUEUE_SIZE 5
+/* Positions an SRS rotation tries, the plain turn first, before it fails */
+#define SRS_KICKS 5
 
+/* Size of the board the views show, see board_t */
 #define BOARD_ROWS 20
 #define BOARD_COLS 10
+/* Piece masks are shifted by this many extra bits, so that columns left of
+ * the board stay representable instead of being shifted out. */
+#define MASK_COL_OFFSET 4
 
 #define BOARDS_BEGIN 2
 
@@ -2,23 +2,13 @@
 
 #include <time.h>
 
-void rotate(game_state *state, board_t *board) {
-  int curr_rotation = board->tetramino_curr.rotation;
-  board->tetramino_curr.rotation =
-      (board->tetramino_curr.rotation + 1) %
-      (board->tetramino_curr.figure.max_rotation + 1);
-  if (check_board_collide(&(board->tetramino_curr), board)) {
-    board->tetramino_curr.rotation = curr_rotation;
-    *state = ATTACHING;
-  } else {
-    while (check_lborder_collide(&(board->tetramino_curr)))
-      board->tetramino_curr.col_pos++;
-    while (check_rborder_collide(&(board->tetramino_curr)))
-      board->tetramino_curr.col_pos--;
-  }
+template <int Rows, int Cols>
+void rotate(basic_board_t<Rows, Cols> *board) {
+  rotate_tetramino(board, &board->tetramino_curr);
 }
 
-void movedown(game_state *state, board_t *board) {
+template <int Rows, int Cols>
+void movedown(game_state *state, basic_board_t<Rows, Cols> *board) {
   tetramino_t tmp = board->tetramino_curr;
   tmp.row_pos++;
   if (!check_board_collide(&tmp, board)) {
@@ -29,15 +19,24 @@ void movedown(game_state *state, board_t *board) {
   }
 }
 
-void moveright(board_t *board) {
+template <int Rows, int Cols>
+void harddrop(game_state *state, basic_board_t<Rows, Cols> *board) {
+  board->tetramino_curr.row_pos +=
+      drop_distance(board, &board->tetramino_curr);
+  *state = ATTACHING;
+}
+
+template <int Rows, int Cols>
+void moveright(basic_board_t<Rows, Cols> *board) {
   tetramino_t tmp = board->tetramino_curr;
   tmp.col_pos++;
-  if (!check_rborder_collide(&tmp) && !check_board_collide(&tmp, board)) {
+  if (!check_rborder_collide<Cols>(&tmp) && !check_board_collide(&tmp, board)) {
     board->tetramino_curr.col_pos++;
   }
 }
 
-void moveleft(board_t *board) {
+template <int Rows, int Cols>
+void moveleft(basic_board_t<Rows, Cols> *board) {
   tetramino_t tmp = board->tetramino_curr;
   tmp.col_pos--;
   if (!check_lborder_collide(&tmp) && !check_board_collide(&tmp, board)) {
@@ -60,14 +59,17 @@ void on_start_state(signals sig, game_state *state, game_stats_t *stats) {
   }
 }
 
-void on_spawn_state(game_state *state, board_t *board) {
+template <int Rows, int Cols>
+void on_spawn_state(game_state *state, game_stats_t *stats,
+                    basic_board_t<Rows, Cols> *board) {
   *state = MOVING;
 
   board->tetramino_curr = board->tetramino_next;
-  board->tetramino_next = gen_next_tetramino();
+  board->tetramino_next = gen_next_tetramino(board);
 
   if (check_board_collide(&(board->tetramino_curr), board)) {
     *state = GAMEOVER;
+    if (stats->persist_high_score) flush_high_score();
   }
 }
 
@@ -78,14 +80,19 @@ void on_pause_state(signals sig, game_state *state) {
   }
 }
 
-void on_moving_state(signals sig, game_state *state, board_t *board) {
+template <int Rows, int Cols>
+void on_moving_state(signals sig, game_state *state,
+                     basic_board_t<Rows, Cols> *board) {
   switch (sig) {
     case ACTION_BTN:
-      rotate(state, board);
+      rotate(board);
       break;
     case MOVE_DOWN:
       movedown(state, board);
       break;
+    case HARD_DROP:
+      harddrop(state, board);
+      break;
     case MOVE_RIGHT:
       moveright(board);
       break;
@@ -103,31 +110,31 @@ void on_moving_state(signals sig, game_state *state, board_t *board) {
   }
 }
 
-void on_attach_state(game_state *state, game_stats_t *stats, board_t *board) {
+template <int Rows, int Cols>
+void on_attach_state(game_state *state, game_stats_t *stats,
+                     basic_board_t<Rows, Cols> *board) {
   attach_tetramino(board);
-  int rows_removed = 0;
-  int full_row_number = 0;
-  while ((full_row_number = find_full_rows(board)) && full_row_number != -1) {
-    shift_board(board, full_row_number);
-    rows_removed++;
-  }
-  update_score(stats, rows_removed);
+  board->cleared_rows = clear_full_rows(board, board->tetramino_curr.row_pos);
+  update_score(stats, __builtin_popcountll(board->cleared_rows));
 
   *state = SPAWN;
 }
 
-void on_move_state(game_state *state, game_stats_t *stats, board_t *board) {
+template <int Rows, int Cols>
+void on_move_state(game_state *state, game_stats_t *stats,
+                   basic_board_t<Rows, Cols> *board) {
   stats->next_advance_time_in_ms =
       timeInMilliseconds() + 500 - 50 * (stats->level - 1);
   movedown(state, board);
 }
 
+template <int Rows, int Cols>
 void on_gameover_state(signals sig, game_state *state, game_stats_t *stats,
-                       board_t *board) {
+                       basic_board_t<Rows, Cols> *board) {
   stats->level = kLoose;
   if (sig == START_BTN) {
-    init_board(board);
-    init_stats(stats);
+    reset_board(board);
+    reset_stats(stats);
     stats->level = kLevel1;
     *state = SPAWN;
   } else if (sig == ESCAPE_BTN)
@@ -135,14 +142,15 @@ void on_gameover_state(signals sig, game_state *state, game_stats_t *stats,
 }
 
 // cppcheck-suppress unusedFunction
+template <int Rows, int Cols>
 void sigact(signals sig, game_state *state, game_stats_t *stats,
-            board_t *board) {
+            basic_board_t<Rows, Cols> *board) {
   switch (*state) {
     case START:
       on_start_state(sig, state, stats);
       break;
     case SPAWN:
-      on_spawn_state(state, board);
+      on_spawn_state(state, stats, board);
       break;
     case MOVING:
       on_moving_state(sig, state, board);
@@ -162,4 +170,28 @@ void sigact(signals sig, game_state *state, game_stats_t *stats,
     default:
       break;
   }
-}
\ No newline at end of file
+}
+
+/* The board sizes the game logic is compiled for, see board_t. */
+#define INSTANTIATE_FSM_FUNCTIONS(Board)                                     \
+  template void rotate(Board *board);                                        \
+  template void movedown(game_state *state, Board *board);                   \
+  template void harddrop(game_state *state, Board *board);                   \
+  template void moveright(Board *board);                                     \
+  template void moveleft(Board *board);                                      \
+  template void on_spawn_state(game_state *state, game_stats_t *stats,       \
+                               Board *board);                                \
+  template void on_moving_state(signals sig, game_state *state,              \
+                                Board *board);                               \
+  template void on_attach_state(game_state *state, game_stats_t *stats,      \
+                                Board *board);                               \
+  template void on_move_state(game_state *state, game_stats_t *stats,        \
+                              Board *board);                                 \
+  template void on_gameover_state(signals sig, game_state *state,            \
+                                  game_stats_t *stats, Board *board);        \
+  template void sigact(signals sig, game_state *state, game_stats_t *stats,  \
+                       Board *board);
+
+INSTANTIATE_FSM_FUNCTIONS(board_t)
+INSTANTIATE_FSM_FUNCTIONS(tall_board_t)
+INSTANTIATE_FSM_FUNCTIONS(square_board_t)
@@ -40,6 +40,8 @@ typedef enum {
  * - START_BTN: The start button is pressed.
  * - ESCAPE_BTN: The escape button is pressed, indicating the game should end.
  * - NOSIG: No signal is received.
+ * - HARD_DROP: The up arrow key is pressed, dropping the piece to the stack.
+ *   It comes last so the other signals keep their values.
  */
 typedef enum {
   ACTION_BTN = 0,  // spacebar
@@ -49,16 +51,18 @@ typedef enum {
   PAUSE_BTN,
   START_BTN,
   ESCAPE_BTN,  // end game
-  NOSIG
+  NOSIG,
+  HARD_DROP
 } signals;
 
 /**
- * Rotates the current game piece clockwise.
+ * Rotates the current game piece clockwise with SRS wall kicks. A piece that
+ * cannot turn stays as it is.
  *
- * @param state The current game state.
  * @param board The current game board.
  */
-void rotate(game_state *state, board_t *board);
+template <int Rows, int Cols>
+void rotate(basic_board_t<Rows, Cols> *board);
 
 /**
  * Moves the current game piece down on the board.
@@ -66,21 +70,33 @@ void rotate(game_state *state, board_t *board);
  * @param state The current game state.
  * @param board The current game board.
  */
-void movedown(game_state *state, board_t *board);
+template <int Rows, int Cols>
+void movedown(game_state *state, basic_board_t<Rows, Cols> *board);
+
+/**
+ * Drops the current game piece onto the stack and sends it to attaching.
+ *
+ * @param state The current game state.
+ * @param board The current game board.
+ */
+template <int Rows, int Cols>
+void harddrop(game_state *state, basic_board_t<Rows, Cols> *board);
 
 /**
  * Moves the current game piece to the right on the board.
  *
  * @param board The current game board.
  */
-void moveright(board_t *board);
+template <int Rows, int Cols>
+void moveright(basic_board_t<Rows, Cols> *board);
 
 /**
  * Moves the current game piece to the left on the board.
  *
  * @param board The current game board.
  */
-void moveleft(board_t *board);
+template <int Rows, int Cols>
+void moveleft(basic_board_t<Rows, Cols> *board);
 
 /**
  * Handles the start state of the game state machine.
@@ -97,7 +113,9 @@ void on_start_state(signals sig, game_state *state, game_stats_t *stats);
  * @param stats The current game statistics.
  * @param board The current game board.
  */
-void on_spawn_state(game_state *state, board_t *board);
+template <int Rows, int Cols>
+void on_spawn_state(game_state *state, game_stats_t *stats,
+                    basic_board_t<Rows, Cols> *board);
 
 /**
  * Handles the pause state of the game state machine.
@@ -115,7 +133,9 @@ void on_pause_state(signals sig, game_state *state);
  * @param stats The current game statistics.
  * @param board The current game board.
  */
-void on_moving_state(signals sig, game_state *state, board_t *board);
+template <int Rows, int Cols>
+void on_moving_state(signals sig, game_state *state,
+                     basic_board_t<Rows, Cols> *board);
 
 /**
  * Handles the attach state of the game state machine.
@@ -124,7 +144,9 @@ void on_moving_state(signals sig, game_state *state, board_t *board);
  * @param stats The current game statistics.
  * @param board The current game board.
  */
-void on_attach_state(game_state *state, game_stats_t *stats, board_t *board);
+template <int Rows, int Cols>
+void on_attach_state(game_state *state, game_stats_t *stats,
+                     basic_board_t<Rows, Cols> *board);
 
 /**
  * Handles the move state of the game state machine.
@@ -133,7 +155,9 @@ void on_attach_state(game_state *state, game_stats_t *stats, board_t *board);
  * @param stats The current game statistics.
  * @param board The current game board.
  */
-void on_move_state(game_state *state, game_stats_t *stats, board_t *board);
+template <int Rows, int Cols>
+void on_move_state(game_state *state, game_stats_t *stats,
+                   basic_board_t<Rows, Cols> *board);
 
 /**
  * Handles the game over state of the game state machine.
@@ -143,8 +167,9 @@ void on_move_state(game_state *state, game_stats_t *stats, board_t *board);
  * @param stats The current game statistics.
  * @param board The current game board.
  */
+template <int Rows, int Cols>
 void on_gameover_state(signals sig, game_state *state, game_stats_t *stats,
-                       board_t *board);
+                       basic_board_t<Rows, Cols> *board);
 
 /**
  * Retrieves the signal corresponding to the given user input.
@@ -162,7 +187,8 @@ signals getSignal(int user_input);
  * @param stats The current game statistics.
  * @param board The current game board.
  */
+template <int Rows, int Cols>
 void sigact(signals sig, game_state *state, game_stats_t *stats,
-            board_t *board);
+            basic_board_t<Rows, Cols> *board);
 
 #endif
\ No newline at end of file
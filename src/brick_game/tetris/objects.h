@@ -1,50 +1,114 @@
 #ifndef OBJECTS_H
 #define OBJECTS_H
 #include <cstdint>
+#include <type_traits>
 
 #include "defines_tetris.h"
+#include "tetris_randomizer.h"
 
 /**
  * Represents a tetris figure, including its sprite and maximum number of
  * rotations.
+ *
+ * The sprite of each rotation is a 4x4 grid stored as `row_mask[rotation]`,
+ * one bit per sprite column (bit j for column j). `col_mask[rotation]` is
+ * the union of the rotation's row masks. They let collision checks test a
+ * whole piece row with a single shift and AND. `col_top` and `col_bottom`
+ * are the first and last sprite rows filled in each sprite column, -1 for an
+ * empty column; a piece column has no gaps between them. All figures live in
+ * a static table, see tetramino_figure().
  */
 typedef struct {
-  int sprite[4][4][4];
+  uint16_t row_mask[4][4];
+  uint16_t col_mask[4];
+  int8_t col_top[4][4];
+  int8_t col_bottom[4][4];
   int max_rotation;
   int figure_color;
 } figure_t;
 
 /**
  * Represents a tetromino, which is a Tetris piece. It includes the current row
- * and column position, the figure (sprite) of the tetromino, and the current
- * rotation.
+ * and column position, the index of its figure in the piece table, and the
+ * current rotation, packed into four bytes.
  */
 typedef struct {
-  int row_pos;
-  int col_pos;
-  figure_t figure;
-  int rotation;
+  int8_t row_pos;
+  int8_t col_pos;
+  uint8_t piece;
+  int8_t rotation;
 } tetramino_t;
 
 /**
  * Represents the game board, including the current and next tetramino, and the
  * state of the board.
+ *
+ * The board dimensions are template parameters, so every board size gets its
+ * own layout and loop bounds known at compile time. `board_t` is the
+ * BOARD_ROWS x BOARD_COLS board the views and the controller use. The game
+ * logic is also compiled for `tall_board_t` and `square_board_t`, so those
+ * sizes can be played headless.
+ *
+ * `rows` mirrors `board` as one bitmask per row, bit c set where column c is
+ * filled. The game logic works on `rows` only; the color grid in `board` is
+ * kept in sync for rendering. `cleared_rows` is the set of rows removed by
+ * the last attached piece (bit r for row r, as numbered before the clear).
+ * `heights` and `holes` cache, per column, the height of the stack and the
+ * number of empty cells under its top; they are updated with every attached
+ * piece and cleared row.
+ * `dirty_rows` collects the rows whose cells in `board` changed (bit r for
+ * row r) until a renderer takes and resets it.
+ * `randomizer` deals the pieces; its queue holds the pieces that follow
+ * `tetramino_next`.
+ *
+ * @tparam Rows The number of board rows, at most 64.
+ * @tparam Cols The number of board columns, at most 32.
  */
-typedef struct {
-  int board[BOARD_ROWS][BOARD_COLS];
+template <int Rows, int Cols>
+struct basic_board_t {
+  static_assert(Rows >= 4 && Rows <= 64, "a row set has one bit per row");
+  static_assert(Cols >= 4 && Cols <= 32, "a row mask has one bit per column");
+
+  /* One bit per column, as narrow as the board allows */
+  typedef std::conditional_t<(Cols <= 16), uint16_t, uint32_t> row_mask_t;
+  /* One bit per row */
+  typedef std::conditional_t<(Rows <= 32), uint32_t, uint64_t> row_set_t;
+
+  static constexpr int kRows = Rows;
+  static constexpr int kCols = Cols;
+  static constexpr row_mask_t kFullRowMask =
+      (row_mask_t)((uint64_t{1} << Cols) - 1);
+  static constexpr row_set_t kAllRowsMask =
+      (row_set_t)(~uint64_t{0} >> (64 - Rows));
+
+  int board[Rows][Cols];
+  row_mask_t rows[Rows];
+  uint8_t heights[Cols];
+  uint8_t holes[Cols];
+  row_set_t cleared_rows;
+  row_set_t dirty_rows;
   tetramino_t tetramino_curr;
   tetramino_t tetramino_next;
-} board_t;
+  randomizer_t randomizer;
+};
+
+typedef basic_board_t<BOARD_ROWS, BOARD_COLS> board_t;
+typedef basic_board_t<40, 10> tall_board_t;
+typedef basic_board_t<32, 32> square_board_t;
 
 /**
  * Represents the current game statistics, including the player's score, high
  * score, current level, and the time until the next level advancement.
+ *
+ * The high score is read from and saved to the high score file only while
+ * `persist_high_score` is set, see init_stats() and init_transient_stats().
  */
 typedef struct {
   int score;
   int high_score;
   int level;
   uint64_t next_advance_time_in_ms;
+  bool persist_high_score;
 } game_stats_t;
 
 #endif
\ No newline at end of file
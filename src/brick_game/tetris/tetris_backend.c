@@ -1,6 +1,25 @@
 #include "tetris_backend.h"
 
+#include <random>
+
+#include "../high_score_writer.h"
+
+static s21::HighScoreWriter &high_score_writer() {
+  static s21::HighScoreWriter writer("./tetris_high_score.txt");
+  return writer;
+}
+
 void init_stats(game_stats_t *stats) {
+  stats->persist_high_score = true;
+  reset_stats(stats);
+}
+
+void init_transient_stats(game_stats_t *stats) {
+  stats->persist_high_score = false;
+  reset_stats(stats);
+}
+
+void reset_stats(game_stats_t *stats) {
   stats->level = 0;
   stats->score = 0;
   stats->high_score = 0;
@@ -8,85 +27,211 @@ void init_stats(game_stats_t *stats) {
   // stats->next_advance_time_in_ms = timeInMilliseconds() + DEFAULT_DELAY_MS;
 }
 
-void init_board(board_t *board) {
-  for (int i = 0; i < BOARD_ROWS; ++i) {
-    for (int j = 0; j < BOARD_COLS; ++j) {
+template <int Rows, int Cols>
+void init_board(basic_board_t<Rows, Cols> *board) {
+  std::random_device entropy;
+  init_board_seeded(board, (uint64_t)entropy() << 32 | entropy(),
+                    RANDOMIZER_BAG7);
+}
+
+template <int Rows, int Cols>
+void init_board_seeded(basic_board_t<Rows, Cols> *board, uint64_t seed,
+                       randomizer_mode_t mode) {
+  seed_randomizer(&board->randomizer, seed, mode);
+  reset_board(board);
+}
+
+template <int Rows, int Cols>
+void reset_board(basic_board_t<Rows, Cols> *board) {
+  for (int i = 0; i < Rows; ++i) {
+    for (int j = 0; j < Cols; ++j) {
       board->board[i][j] = kColorBlack;
     }
+    board->rows[i] = 0;
   }
+  for (int j = 0; j < Cols; ++j) {
+    board->heights[j] = 0;
+    board->holes[j] = 0;
+  }
+  board->cleared_rows = 0;
+  board->dirty_rows = basic_board_t<Rows, Cols>::kAllRowsMask;
 
-  board->tetramino_next = gen_next_tetramino();
+  board->tetramino_next = gen_next_tetramino(board);
 }
 
-bool check_lborder_collide(const tetramino_t *tetramino) {
-  bool rc = false;
-
-  for (int i = 0; i < 4; ++i)
-    for (int j = 0; j < 4; ++j)
-      if (tetramino->figure.sprite[tetramino->rotation][i][j] != 0 &&
-          tetramino->col_pos + j < 0)
-        rc = true;
+/* Piece masks placed on a row, with MASK_COL_OFFSET spare columns on both
+ * sides of the widest board. */
+typedef uint64_t placed_mask_t;
+static_assert(32 + 2 * MASK_COL_OFFSET <= 64,
+              "placed masks hold a row of the widest board and its margins");
+
+/* Returns the piece columns mask placed at the tetramino column, offset by
+ * MASK_COL_OFFSET. */
+static placed_mask_t placed_col_mask(const tetramino_t *tetramino) {
+  return (placed_mask_t)tetramino_figure(tetramino)
+             ->col_mask[tetramino->rotation]
+         << (tetramino->col_pos + MASK_COL_OFFSET);
+}
 
-  return rc;
+bool check_lborder_collide(const tetramino_t *tetramino) {
+  return (placed_col_mask(tetramino) & ((1u << MASK_COL_OFFSET) - 1)) != 0;
 }
 
+template <int Cols>
 bool check_rborder_collide(const tetramino_t *tetramino) {
-  bool rc = false;
+  return (placed_col_mask(tetramino) >> (Cols + MASK_COL_OFFSET)) != 0;
+}
 
-  for (int i = 0; i < 4; ++i)
-    for (int j = 0; j < 4; ++j)
-      if (tetramino->figure.sprite[tetramino->rotation][i][j] != 0 &&
-          tetramino->col_pos + j > BOARD_COLS - 1)
-        rc = true;
+template <int Rows, int Cols>
+bool check_board_collide(const tetramino_t *tetramino,
+                         const basic_board_t<Rows, Cols> *board) {
+  const uint16_t *piece =
+      tetramino_figure(tetramino)->row_mask[tetramino->rotation];
+  const int shift = tetramino->col_pos + MASK_COL_OFFSET;
+  placed_mask_t hit = 0;
+
+  for (int i = 0; i < 4; ++i) {
+    int row = tetramino->row_pos + i;
+    if (piece[i] == 0) continue;
+    if (row < 0 || row > Rows - 1) return true;
+    hit |= ((placed_mask_t)piece[i] << shift) &
+           ((placed_mask_t)board->rows[row] << MASK_COL_OFFSET);
+  }
 
-  return rc;
+  return hit != 0;
 }
 
-bool check_board_collide(const tetramino_t *tetramino, const board_t *board) {
-  bool rc = false;
-
-  for (int i = 0; i < 4; ++i)
-    for (int j = 0; j < 4; ++j) {
-      if (tetramino->figure.sprite[tetramino->rotation][i][j] != 0 &&
-          tetramino->row_pos + i > BOARD_ROWS - 1)
-        rc = true;
-      if (tetramino->figure.sprite[tetramino->rotation][i][j] != 0 &&
-          board->board[tetramino->row_pos + i][tetramino->col_pos + j] != 0)
-        rc = true;
+/* Updates the height and holes of the columns a piece is locked in. Piece
+ * cells in a column are contiguous, so they either fill holes under the
+ * column top or stack above it, leaving a gap of new holes below them. */
+template <int Rows, int Cols>
+static void add_piece_to_columns(basic_board_t<Rows, Cols> *board,
+                                 const tetramino_t *curr) {
+  const figure_t *figure = tetramino_figure(curr);
+  for (int j = 0; j < 4; ++j) {
+    if (figure->col_top[curr->rotation][j] < 0) continue;
+    int col = curr->col_pos + j;
+    int top = curr->row_pos + figure->col_top[curr->rotation][j];
+    int bottom = curr->row_pos + figure->col_bottom[curr->rotation][j];
+    int stack_top = Rows - board->heights[col];
+    if (bottom < stack_top) {
+      board->heights[col] = (uint8_t)(Rows - top);
+      board->holes[col] += (uint8_t)(stack_top - 1 - bottom);
+    } else {
+      board->holes[col] -= (uint8_t)(bottom - top + 1);
     }
+  }
+}
 
-  return rc;
+/* Lowers every column by the cleared rows. A column whose new top cell is
+ * empty was only held up by them; its holes under the new top are not holes
+ * any more. */
+template <int Rows, int Cols>
+static void remove_rows_from_columns(basic_board_t<Rows, Cols> *board,
+                                     int cleared) {
+  for (int col = 0; col < Cols; ++col) {
+    int height = board->heights[col] - cleared;
+    int holes = board->holes[col];
+    while (height > 0 && !(board->rows[Rows - height] & (1u << col))) {
+      --height;
+      --holes;
+    }
+    board->heights[col] = (uint8_t)height;
+    board->holes[col] = (uint8_t)holes;
+  }
 }
 
-void attach_tetramino(board_t *board) {
-  for (int i = 0; i < 4; ++i)
-    for (int j = 0; j < 4; ++j)
-      if (board->tetramino_curr.figure
-              .sprite[board->tetramino_curr.rotation][i][j] != 0)
-        board->board[board->tetramino_curr.row_pos + i]
-                    [board->tetramino_curr.col_pos + j] =
-            board->tetramino_curr.figure.figure_color;
+template <int Rows, int Cols>
+int board_holes(const basic_board_t<Rows, Cols> *board) {
+  int holes = 0;
+  for (int col = 0; col < Cols; ++col) holes += board->holes[col];
+  return holes;
 }
 
-int find_full_rows(const board_t *board) {
-  int full_row = -1;
-  for (int row = 0; row < BOARD_ROWS; ++row) {
-    int filled_count = 0;
-    for (int col = 0; col < BOARD_COLS; ++col) {
-      if (board->board[row][col] != 0) filled_count++;
-    }
-    if (filled_count == BOARD_COLS) {
-      full_row = row;
-      break;
+template <int Rows, int Cols>
+int drop_distance(const basic_board_t<Rows, Cols> *board,
+                  const tetramino_t *tetramino) {
+  const figure_t *figure = tetramino_figure(tetramino);
+  int distance = Rows;
+  for (int j = 0; j < 4; ++j) {
+    if (figure->col_top[tetramino->rotation][j] < 0) continue;
+    int col = tetramino->col_pos + j;
+    int bottom =
+        tetramino->row_pos + figure->col_bottom[tetramino->rotation][j];
+    int free_below = Rows - board->heights[col] - 1 - bottom;
+    if (free_below < 0) {
+      // Tucked under an overhang: the stack top says nothing here
+      tetramino_t probe = *tetramino;
+      distance = 0;
+      for (probe.row_pos++; !check_board_collide(&probe, board);
+           probe.row_pos++)
+        ++distance;
+      return distance;
     }
+    if (free_below < distance) distance = free_below;
   }
-  return full_row;
+  return distance;
 }
 
-void shift_board(board_t *board, int row_number) {
-  for (int row = row_number; row > 0; --row)
-    for (int col = 0; col < BOARD_COLS; ++col)
-      board->board[row][col] = board->board[row - 1][col];
+template <int Rows, int Cols>
+void attach_tetramino(basic_board_t<Rows, Cols> *board) {
+  typedef typename basic_board_t<Rows, Cols>::row_mask_t row_mask_t;
+  typedef typename basic_board_t<Rows, Cols>::row_set_t row_set_t;
+  const tetramino_t *curr = &board->tetramino_curr;
+  const figure_t *figure = tetramino_figure(curr);
+  add_piece_to_columns(board, curr);
+  for (int i = 0; i < 4; ++i) {
+    uint16_t piece = figure->row_mask[curr->rotation][i];
+    if (piece == 0) continue;
+    int row = curr->row_pos + i;
+    placed_mask_t placed =
+        ((placed_mask_t)piece << (curr->col_pos + MASK_COL_OFFSET)) >>
+        MASK_COL_OFFSET;
+    board->rows[row] |= (row_mask_t)placed;
+    board->dirty_rows |= (row_set_t)1 << row;
+    for (int j = 0; j < 4; ++j)
+      if (piece & (1u << j))
+        board->board[row][curr->col_pos + j] = figure->figure_color;
+  }
+}
+
+template <int Rows, int Cols>
+typename basic_board_t<Rows, Cols>::row_set_t find_full_rows(
+    const basic_board_t<Rows, Cols> *board, int first_row) {
+  typedef typename basic_board_t<Rows, Cols>::row_set_t row_set_t;
+  row_set_t full_rows = 0;
+  for (int row = first_row; row < first_row + 4 && row < Rows; ++row)
+    if (row >= 0 && board->rows[row] == basic_board_t<Rows, Cols>::kFullRowMask)
+      full_rows |= (row_set_t)1 << row;
+  return full_rows;
+}
+
+template <int Rows, int Cols>
+typename basic_board_t<Rows, Cols>::row_set_t clear_full_rows(
+    basic_board_t<Rows, Cols> *board, int first_row) {
+  typedef typename basic_board_t<Rows, Cols>::row_set_t row_set_t;
+  row_set_t full_rows = find_full_rows(board, first_row);
+  if (full_rows == 0) return 0;
+
+  // Walk up from the lowest full row, moving every kept row down over the
+  // cleared ones, then empty the rows left free at the top.
+  const int lowest = 63 - __builtin_clzll(full_rows);
+  int dst = lowest;
+  for (int src = dst - 1; src >= 0; --src) {
+    if (full_rows & ((row_set_t)1 << src)) continue;
+    board->rows[dst] = board->rows[src];
+    memcpy(board->board[dst], board->board[src], sizeof(board->board[src]));
+    --dst;
+  }
+  for (; dst >= 0; --dst) {
+    board->rows[dst] = 0;
+    memset(board->board[dst], 0, sizeof(board->board[dst]));
+  }
+  remove_rows_from_columns(board, __builtin_popcountll(full_rows));
+  // Every row down to the lowest cleared one moved or was emptied
+  board->dirty_rows |= basic_board_t<Rows, Cols>::kAllRowsMask >>
+                       (Rows - 1 - lowest);
+  return full_rows;
 }
 
 void update_score(game_stats_t *stats, int rows_removed) {
@@ -117,164 +262,149 @@ void update_score(game_stats_t *stats, int rows_removed) {
   if (stats->level > MAX_LEVEL) stats->level = MAX_LEVEL;
 }
 
-tetramino_t gen_next_tetramino() {
-  figure_t figures[TETRAMINOS] = {
-      {.sprite = {0}, .max_rotation = 0, .figure_color = 0}};
-  /*
-  ####
-  */
-  figures[0].figure_color = kColorCyan;
-  figures[0].max_rotation = 1;
-  figures[0].sprite[0][0][1] = 1;
-  figures[0].sprite[0][1][1] = 1;
-  figures[0].sprite[0][2][1] = 1;
-  figures[0].sprite[0][3][1] = 1;
-
-  figures[0].sprite[1][1][0] = 1;
-  figures[0].sprite[1][1][1] = 1;
-  figures[0].sprite[1][1][2] = 1;
-  figures[0].sprite[1][1][3] = 1;
-  /*
-  ##
-   ##
-  */
-  figures[1].figure_color = kColorRed;
-  figures[1].max_rotation = 1;
-  figures[1].sprite[0][0][0] = 1;
-  figures[1].sprite[0][0][1] = 1;
-  figures[1].sprite[0][1][1] = 1;
-  figures[1].sprite[0][1][2] = 1;
-
-  figures[1].sprite[1][0][1] = 1;
-  figures[1].sprite[1][1][0] = 1;
-  figures[1].sprite[1][1][1] = 1;
-  figures[1].sprite[1][2][0] = 1;
-  /*
-   ##
-  ##
-  */
-  figures[2].figure_color = kColorGreen;
-  figures[2].max_rotation = 1;
-  figures[2].sprite[0][0][1] = 1;
-  figures[2].sprite[0][0][2] = 1;
-  figures[2].sprite[0][1][0] = 1;
-  figures[2].sprite[0][1][1] = 1;
-
-  figures[2].sprite[1][0][0] = 1;
-  figures[2].sprite[1][1][0] = 1;
-  figures[2].sprite[1][1][1] = 1;
-  figures[2].sprite[1][2][1] = 1;
-  /*
-   #
-  ###
-  */
-  figures[3].figure_color = kColorMagenta;
-  figures[3].max_rotation = 3;
-  figures[3].sprite[0][0][1] = 1;
-  figures[3].sprite[0][1][0] = 1;
-  figures[3].sprite[0][1][1] = 1;
-  figures[3].sprite[0][1][2] = 1;
-
-  figures[3].sprite[1][0][1] = 1;
-  figures[3].sprite[1][1][1] = 1;
-  figures[3].sprite[1][1][2] = 1;
-  figures[3].sprite[1][2][1] = 1;
-
-  figures[3].sprite[2][1][0] = 1;
-  figures[3].sprite[2][1][1] = 1;
-  figures[3].sprite[2][1][2] = 1;
-  figures[3].sprite[2][2][1] = 1;
-
-  figures[3].sprite[3][0][1] = 1;
-  figures[3].sprite[3][1][0] = 1;
-  figures[3].sprite[3][1][1] = 1;
-  figures[3].sprite[3][2][1] = 1;
-  /*
-   #
-   #
-   ##
-  */
-  figures[4].figure_color = kColorWhite;
-  figures[4].max_rotation = 3;
-  figures[4].sprite[0][0][1] = 1;
-  figures[4].sprite[0][1][1] = 1;
-  figures[4].sprite[0][2][1] = 1;
-  figures[4].sprite[0][2][2] = 1;
-
-  figures[4].sprite[1][1][0] = 1;
-  figures[4].sprite[1][1][1] = 1;
-  figures[4].sprite[1][1][2] = 1;
-  figures[4].sprite[1][2][0] = 1;
-
-  figures[4].sprite[2][0][0] = 1;
-  figures[4].sprite[2][0][1] = 1;
-  figures[4].sprite[2][1][1] = 1;
-  figures[4].sprite[2][2][1] = 1;
-
-  figures[4].sprite[3][0][2] = 1;
-  figures[4].sprite[3][1][0] = 1;
-  figures[4].sprite[3][1][1] = 1;
-  figures[4].sprite[3][1][2] = 1;
-  /*
-   #
-   #
-  ##
-  */
-  figures[5].figure_color = kColorBlue;
-  figures[5].max_rotation = 3;
-  figures[5].sprite[0][0][1] = 1;
-  figures[5].sprite[0][1][1] = 1;
-  figures[5].sprite[0][2][0] = 1;
-  figures[5].sprite[0][2][1] = 1;
-
-  figures[5].sprite[1][0][0] = 1;
-  figures[5].sprite[1][1][0] = 1;
-  figures[5].sprite[1][1][1] = 1;
-  figures[5].sprite[1][1][2] = 1;
-
-  figures[5].sprite[2][0][0] = 1;
-  figures[5].sprite[2][0][1] = 1;
-  figures[5].sprite[2][1][0] = 1;
-  figures[5].sprite[2][2][0] = 1;
-
-  figures[5].sprite[3][1][0] = 1;
-  figures[5].sprite[3][1][1] = 1;
-  figures[5].sprite[3][1][2] = 1;
-  figures[5].sprite[3][2][2] = 1;
-  /*
-  ##
-  ##
-  */
-  figures[6].figure_color = kColorYellow;
-  figures[6].max_rotation = 0;
-  figures[6].sprite[0][0][0] = 1;
-  figures[6].sprite[0][0][1] = 1;
-  figures[6].sprite[0][1][0] = 1;
-  figures[6].sprite[0][1][1] = 1;
-
-  tetramino_t tetramino = {
-      .row_pos = 0, .col_pos = 0, .figure = {}, .rotation = 0};
-  srand(time(NULL));
-  tetramino.figure = figures[rand() % TETRAMINOS];
-  tetramino.col_pos = BOARD_COLS / 2 - 1;
-  tetramino.row_pos = 0;
-  tetramino.rotation = 0;
+/* Builds a figure from a drawing of its rotations, placed side by side: row
+ * i of rotation r is the four characters starting at sheet[i][5 * r], with
+ * '#' for filled cells. */
+static constexpr figure_t make_figure(int color, int max_rotation,
+                                      const char *const (&sheet)[4]) {
+  figure_t figure = {};
+  for (int rotation = 0; rotation < 4; ++rotation) {
+    for (int j = 0; j < 4; ++j) {
+      figure.col_top[rotation][j] = -1;
+      figure.col_bottom[rotation][j] = -1;
+    }
+    for (int i = 0; i < 4; ++i) {
+      uint16_t mask = 0;
+      for (int j = 0; j < 4; ++j) {
+        if (sheet[i][5 * rotation + j] != '#') continue;
+        mask |= (uint16_t)(1u << j);
+        if (figure.col_top[rotation][j] < 0) figure.col_top[rotation][j] = i;
+        figure.col_bottom[rotation][j] = i;
+      }
+      figure.row_mask[rotation][i] = mask;
+      figure.col_mask[rotation] |= mask;
+    }
+  }
+  figure.max_rotation = max_rotation;
+  figure.figure_color = color;
+  return figure;
+}
+
+/* All pieces with their rotations, indexed by tetramino_t::piece. The
+ * rotations are the four Super Rotation System states in clockwise order
+ * (spawn, right, two, left), drawn in the SRS bounding boxes. */
+static constexpr figure_t kFigures[TETRAMINOS] = {
+    make_figure(kColorCyan, 3,
+                {".... ..#. .... .#..",
+                 "#### ..#. .... .#..",
+                 ".... ..#. #### .#..",
+                 ".... ..#. .... .#.."}),
+    make_figure(kColorRed, 3,
+                {"##.. ..#. .... .#..",
+                 ".##. .##. ##.. ##..",
+                 ".... .#.. .##. #...",
+                 ".... .... .... ...."}),
+    make_figure(kColorGreen, 3,
+                {".##. .#.. .... #...",
+                 "##.. .##. .##. ##..",
+                 ".... ..#. ##.. .#..",
+                 ".... .... .... ...."}),
+    make_figure(kColorMagenta, 3,
+                {".#.. .#.. .... .#..",
+                 "###. .##. ###. ##..",
+                 ".... .#.. .#.. .#..",
+                 ".... .... .... ...."}),
+    make_figure(kColorWhite, 3,
+                {"..#. .#.. .... ##..",
+                 "###. .#.. ###. .#..",
+                 ".... .##. #... .#..",
+                 ".... .... .... ...."}),
+    make_figure(kColorBlue, 3,
+                {"#... .##. .... .#..",
+                 "###. .#.. ###. .#..",
+                 ".... .#.. ..#. ##..",
+                 ".... .... .... ...."}),
+    make_figure(kColorYellow, 0,
+                {".##. .... .... ....",
+                 ".##. .... .... ....",
+                 ".... .... .... ....",
+                 ".... .... .... ...."}),
+};
+static_assert(kFigures[0].col_mask[0] == 0xF && kFigures[0].col_mask[1] == 0x4,
+              "the piece table is built at compile time");
+
+/* Index of the I piece, the one piece with a kick table of its own. */
+static constexpr uint8_t kPieceI = 0;
+
+/* A position tried by a rotation, relative to the unkicked one. */
+typedef struct {
+  int8_t col;
+  int8_t row;
+} kick_t;
+
+/* SRS wall kicks of a clockwise turn out of each rotation state, tried in
+ * order. Rows grow downwards here, so the guideline's y offsets are negated.
+ * The I piece has its own table; the O piece never turns. */
+static constexpr kick_t kKicks[4][SRS_KICKS] = {
+    {{0, 0}, {-1, 0}, {-1, -1}, {0, 2}, {-1, 2}},
+    {{0, 0}, {1, 0}, {1, 1}, {0, -2}, {1, -2}},
+    {{0, 0}, {1, 0}, {1, -1}, {0, 2}, {1, 2}},
+    {{0, 0}, {-1, 0}, {-1, 1}, {0, -2}, {-1, -2}},
+};
+static constexpr kick_t kKicksI[4][SRS_KICKS] = {
+    {{0, 0}, {-2, 0}, {1, 0}, {-2, 1}, {1, -2}},
+    {{0, 0}, {-1, 0}, {2, 0}, {-1, -2}, {2, 1}},
+    {{0, 0}, {2, 0}, {-1, 0}, {2, -1}, {-1, 2}},
+    {{0, 0}, {1, 0}, {-2, 0}, {1, 2}, {-2, -1}},
+};
+
+const figure_t *tetramino_figure(const tetramino_t *tetramino) {
+  return &kFigures[tetramino->piece];
+}
+
+template <int Rows, int Cols>
+bool rotate_tetramino(const basic_board_t<Rows, Cols> *board,
+                      tetramino_t *tetramino) {
+  const figure_t *figure = tetramino_figure(tetramino);
+  if (figure->max_rotation == 0) return false;
+
+  const kick_t *kicks =
+      (tetramino->piece == kPieceI ? kKicksI : kKicks)[tetramino->rotation];
+  tetramino_t turned = *tetramino;
+  turned.rotation = (int8_t)((tetramino->rotation + 1) % 4);
+  for (int i = 0; i < SRS_KICKS; ++i) {
+    turned.col_pos = (int8_t)(tetramino->col_pos + kicks[i].col);
+    turned.row_pos = (int8_t)(tetramino->row_pos + kicks[i].row);
+    if (!check_lborder_collide(&turned) &&
+        !check_rborder_collide<Cols>(&turned) &&
+        !check_board_collide(&turned, board)) {
+      *tetramino = turned;
+      return true;
+    }
+  }
+  return false;
+}
+
+template <int Rows, int Cols>
+tetramino_t gen_next_tetramino(basic_board_t<Rows, Cols> *board) {
+  tetramino_t tetramino = {.row_pos = 0,
+                           .col_pos = Cols / 2 - 2,
+                           .piece = randomizer_next(&board->randomizer),
+                           .rotation = 0};
   return tetramino;
 }
 
 int save_high_score(const game_stats_t *stats) {
-  int status = SUCCESS;
-  FILE *file = fopen("./tetris_high_score.txt", "w+");
-  if (file == NULL) {
-    status = ERROR_T;
-  } else {
-    fprintf(file, "%d\n", stats->high_score);
-    fclose(file);
-  }
-  return status;
+  if (!stats->persist_high_score) return SUCCESS;
+  high_score_writer().Submit(stats->high_score);
+  return SUCCESS;
 }
+
+void flush_high_score(void) { high_score_writer().Flush(); }
+
 int load_high_score(game_stats_t *stats) {
   int status = SUCCESS;
+  if (!stats->persist_high_score) return status;
   FILE *file = fopen("./tetris_high_score.txt", "r");
   if (file == NULL) {
     status = ERROR_T;
@@ -290,4 +420,29 @@ uint64_t timeInMilliseconds(void) {
 
   gettimeofday(&tv, NULL);
   return (((uint64_t)tv.tv_sec) * 1000) + (tv.tv_usec / 1000);
-}
\ No newline at end of file
+}
+
+/* The board sizes the game logic is compiled for, see board_t. */
+#define INSTANTIATE_BOARD_FUNCTIONS(Board)                                      \
+  template void init_board(Board *board);                                       \
+  template void init_board_seeded(Board *board, uint64_t seed,                  \
+                                  randomizer_mode_t mode);                      \
+  template void reset_board(Board *board);                                      \
+  template tetramino_t gen_next_tetramino(Board *board);                        \
+  template bool check_board_collide(const tetramino_t *tetramino,               \
+                                    const Board *board);                        \
+  template bool rotate_tetramino(const Board *board, tetramino_t *tetramino);   \
+  template void attach_tetramino(Board *board);                                 \
+  template Board::row_set_t find_full_rows(const Board *board,                  \
+                                           int first_row);                      \
+  template Board::row_set_t clear_full_rows(Board *board, int first_row);       \
+  template int board_holes(const Board *board);                                 \
+  template int drop_distance(const Board *board, const tetramino_t *tetramino);
+
+INSTANTIATE_BOARD_FUNCTIONS(board_t)
+INSTANTIATE_BOARD_FUNCTIONS(tall_board_t)
+INSTANTIATE_BOARD_FUNCTIONS(square_board_t)
+
+template bool check_rborder_collide<BOARD_COLS>(const tetramino_t *tetramino);
+template bool check_rborder_collide<square_board_t::kCols>(
+    const tetramino_t *tetramino);
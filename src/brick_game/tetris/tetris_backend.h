@@ -15,24 +15,71 @@
 #include "objects.h"
 
 /**
- * Initializes the game statistics structure with default values.
+ * Initializes the game statistics structure with default values and the high
+ * score stored in the high score file, which new high scores are saved to.
  *
  * @param stats Pointer to the game_stats_t structure to be initialized.
  */
 void init_stats(game_stats_t *stats);
 /**
- * Initializes the game board with default values.
+ * Initializes the game statistics structure with default values, without
+ * persisting the high score: the high score file is neither read nor
+ * written, e.g. for headless simulations and benchmarks.
+ *
+ * @param stats Pointer to the game_stats_t structure to be initialized.
+ */
+void init_transient_stats(game_stats_t *stats);
+/**
+ * Resets the score and level for a new game, reloading the high score if the
+ * statistics persist it.
+ *
+ * @param stats Pointer to the game_stats_t structure to be reset.
+ */
+void reset_stats(game_stats_t *stats);
+/**
+ * Initializes the game board with default values and a randomizer seeded
+ * from the system entropy source, dealing from 7-piece bags.
  *
  * @param board Pointer to the board_t structure to be initialized.
  */
-void init_board(board_t *board);
+template <int Rows, int Cols>
+void init_board(basic_board_t<Rows, Cols> *board);
+/**
+ * Initializes the game board with a seeded randomizer, for deterministic
+ * simulations and replays.
+ *
+ * @param board Pointer to the board_t structure to be initialized.
+ * @param seed The randomizer seed.
+ * @param mode How the randomizer draws pieces.
+ */
+template <int Rows, int Cols>
+void init_board_seeded(basic_board_t<Rows, Cols> *board, uint64_t seed,
+                       randomizer_mode_t mode);
+/**
+ * Empties the game board and deals the next piece, keeping the randomizer
+ * state, e.g. when a new game starts in the same session.
+ *
+ * @param board Pointer to the board_t structure to be reset.
+ */
+template <int Rows, int Cols>
+void reset_board(basic_board_t<Rows, Cols> *board);
 
 /**
- * Generates the next tetramino to be used in the game.
+ * Looks up the figure of a tetramino in the static piece table.
  *
+ * @param tetramino Pointer to the tetramino.
+ * @return The figure with the tetramino's sprite, rotations and color.
+ */
+const figure_t *tetramino_figure(const tetramino_t *tetramino);
+
+/**
+ * Deals the next tetramino from the board's randomizer.
+ *
+ * @param board Pointer to the board whose randomizer deals the piece.
  * @return The newly generated tetramino.
  */
-tetramino_t gen_next_tetramino();
+template <int Rows, int Cols>
+tetramino_t gen_next_tetramino(basic_board_t<Rows, Cols> *board);
 
 /**
  * Checks if the given tetramino collides with the left border of the game
@@ -47,39 +94,97 @@ bool check_lborder_collide(const tetramino_t *tetramino);
  * Checks if the given tetramino collides with the right border of the game
  * board.
  *
+ * @tparam Cols The number of board columns.
  * @param tetramino Pointer to the tetramino to check for collision.
  * @return true if the tetramino collides with the right border, false
  * otherwise.
  */
+template <int Cols = BOARD_COLS>
 bool check_rborder_collide(const tetramino_t *tetramino);
 /**
- * Checks if the given tetramino collides with the game board.
+ * Checks if the given tetramino collides with the game board: with its
+ * filled cells, the floor or the top edge, which a wall kick could otherwise
+ * lift a piece over. Cells left or right of the board are not
+ * checked here, see check_lborder_collide() and check_rborder_collide().
+ *
+ * Each piece row is tested against the board row mask with one shift and
+ * AND.
  *
  * @param tetramino Pointer to the tetramino to check for collision.
+ * @param board Pointer to the game board.
  * @return true if the tetramino collides with the board, false otherwise.
  */
-bool check_board_collide(const tetramino_t *tetramino, const board_t *board);
+template <int Rows, int Cols>
+bool check_board_collide(const tetramino_t *tetramino,
+                         const basic_board_t<Rows, Cols> *board);
 /**
- * Attaches the current tetramino to the game board.
+ * Turns the tetramino clockwise with the Super Rotation System: the plain
+ * turn is tried first, then the wall kicks of the piece's kick table, and
+ * the first position that fits on the board is taken.
+ *
+ * At most SRS_KICKS positions are probed, each with the row mask checks.
+ *
+ * @param board Pointer to the game board.
+ * @param tetramino Pointer to the tetramino to turn, left as is on failure.
+ * @return true if the tetramino was turned, false if no position fits.
+ */
+template <int Rows, int Cols>
+bool rotate_tetramino(const basic_board_t<Rows, Cols> *board,
+                      tetramino_t *tetramino);
+/**
+ * Attaches the current tetramino to the game board and updates the cached
+ * column heights and holes.
  *
  * @param board Pointer to the game board to attach the tetramino to.
  */
-void attach_tetramino(board_t *board);
+template <int Rows, int Cols>
+void attach_tetramino(basic_board_t<Rows, Cols> *board);
 
 /**
- * Finds the full rows in the game board and returns the number of full rows.
+ * Finds the full rows among the four rows starting at @p first_row, the only
+ * rows a just attached piece can have completed.
+ *
+ * @param board Pointer to the game board.
+ * @param first_row The top row of the attached piece.
+ * @return The set of full rows, bit r set for row r.
+ */
+template <int Rows, int Cols>
+typename basic_board_t<Rows, Cols>::row_set_t find_full_rows(
+    const basic_board_t<Rows, Cols> *board, int first_row);
+/**
+ * Removes the full rows among the four rows starting at @p first_row and
+ * moves the rows above them down, in a single pass over the board.
  *
  * @param board Pointer to the game board.
- * @return The number of full rows in the game board.
+ * @param first_row The top row of the attached piece.
+ * @return The set of cleared rows, bit r set for row r, so views can
+ * animate them without rescanning the board.
  */
-int find_full_rows(const board_t *board);
+template <int Rows, int Cols>
+typename basic_board_t<Rows, Cols>::row_set_t clear_full_rows(
+    basic_board_t<Rows, Cols> *board, int first_row);
 /**
- * Shifts the game board by the specified number of rows.
+ * Returns the number of holes on the board, from the per-column cache.
  *
- * @param board Pointer to the game board to be shifted.
- * @param row_number The number of rows to shift the board.
+ * @param board Pointer to the game board.
+ * @return The empty cells that have a filled cell above them.
  */
-void shift_board(board_t *board, int row_number);
+template <int Rows, int Cols>
+int board_holes(const basic_board_t<Rows, Cols> *board);
+/**
+ * Returns how many rows the tetramino can fall straight down before it lands.
+ *
+ * A piece above the stack lands on the cached column heights, so this takes
+ * one step per piece column. A piece tucked under an overhang falls back to
+ * probing row by row.
+ *
+ * @param board Pointer to the game board.
+ * @param tetramino Pointer to the falling tetramino.
+ * @return The number of free rows below the tetramino.
+ */
+template <int Rows, int Cols>
+int drop_distance(const basic_board_t<Rows, Cols> *board,
+                  const tetramino_t *tetramino);
 /**
  * Updates the game score based on the number of rows removed.
  *
@@ -89,7 +194,9 @@ void shift_board(board_t *board, int row_number);
 void update_score(game_stats_t *stats, int rows_removed);
 
 /**
- * Saves the high score to persistent storage.
+ * Queues the high score for the background writer, which saves it to
+ * persistent storage without blocking the game loop. Does nothing for
+ * statistics that do not persist the high score.
  *
  * @param stats Pointer to the game statistics struct containing the high score
  * to save.
@@ -97,7 +204,13 @@ void update_score(game_stats_t *stats, int rows_removed);
  */
 int save_high_score(const game_stats_t *stats);
 /**
- * Loads the high score from persistent storage.
+ * Asks the background writer to store the queued high score right away, e.g.
+ * when the game is over.
+ */
+void flush_high_score(void);
+/**
+ * Loads the high score from persistent storage. Does nothing for statistics
+ * that do not persist the high score.
  *
  * @param stats Pointer to the game statistics struct to load the high score
  * into.
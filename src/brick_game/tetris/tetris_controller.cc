@@ -1,97 +1,130 @@
 #include "tetris_controller.h"
 
-#include <chrono>
-
 namespace s21 {
 
 Controller* Controller::instance = nullptr;  // Define the static member
+TetrisController* TetrisController::bound_ = nullptr;
 
 TetrisController::TetrisController(GameInfo_t* game_info, game_state* state,
-                                   board_t* board, game_stats_t* stats)
-    : game_info(game_info), state(state), board(board), stats(stats) {
-  if (instance != nullptr) {
-    throw std::runtime_error("Controller instance already exists.");
+                                   board_t* board, game_stats_t* stats,
+                                   GameClock* clock)
+    : timestep_(clock != nullptr ? clock : DefaultGameClock(),
+                std::chrono::milliseconds(kTetrisTickInMs),
+                kTetrisMaxCatchUpTicks),
+      game_info(game_info),
+      state(state),
+      board(board),
+      stats(stats) {
+  if (bound_ == nullptr) {
+    bound_ = this;
+  }
+  if (instance == nullptr) {
+    instance = this;
   }
-  instance = this;
 };
 
-void TetrisController::UpdateCurrentState() {
-  *game_info = ::updateCurrentState();
-}
-
-void TetrisController::processUserInput(UserAction_t action,
-                                        [[maybe_unused]] bool hold) {
-  ::userInput(action, hold);
+TetrisController::~TetrisController() {
+  if (bound_ == this) {
+    bound_ = nullptr;
+  }
+  if (instance == this) {
+    instance = nullptr;
+  }
 }
 
-std::chrono::_V2::system_clock::time_point frame_start_in_ms =
-    std::chrono::system_clock::now();
-}  // namespace s21
-
-GameInfo_t updateCurrentState() {
-  GameInfo_t* game_info =
-      (dynamic_cast<s21::TetrisController*>(s21::Controller::instance))
-          ->game_info;
-  const game_state* game_state =
-      (dynamic_cast<s21::TetrisController*>(s21::Controller::instance))->state;
-  const game_stats_t* game_stats =
-      (dynamic_cast<s21::TetrisController*>(s21::Controller::instance))->stats;
-  board_t* game_board =
-      (dynamic_cast<s21::TetrisController*>(s21::Controller::instance))->board;
-
-  auto current_time_in_ms = std::chrono::system_clock::now();
-  auto elapsed_time_in_ms =
-      std::chrono::duration_cast<std::chrono::milliseconds>(
-          current_time_in_ms - s21::frame_start_in_ms)
-          .count();
-  if (elapsed_time_in_ms > (500 - 35 * game_stats->level)) {
-    s21::frame_start_in_ms = current_time_in_ms;
-    userInput(UserAction_t::Down, false);
+void TetrisController::UpdateCurrentState() {
+  for (int drops = ConsumeGravityDrops(); drops > 0; --drops) {
+    processUserInput(UserAction_t::Down, false);
   }
 
-  game_info->score = game_stats->score;
-  game_info->level = game_stats->level;
-  game_info->high_score = game_stats->high_score;
-  game_info->pause = (*game_state == PAUSE);
-  if (*game_state == GAMEOVER) {
+  game_info->score = stats->score;
+  game_info->level = stats->level;
+  game_info->high_score = stats->high_score;
+  game_info->pause = (*state == PAUSE);
+  if (*state == GAMEOVER) {
     game_info->level = kLoose;
   }
 
-  // deep copy of the board
-  for (int i = 0; i < kFieldHeight; i++) {
-    for (int j = 0; j < kFieldWidth; j++) {
-      game_info->field[i][j] = game_board->board[i][j];
+  cell_diff_.Clear();
+  RenderField();
+  RenderNext();
+  drawn_ = true;
+}
+
+namespace {
+
+bool SameTetramino(const tetramino_t& a, const tetramino_t& b) {
+  return a.row_pos == b.row_pos && a.col_pos == b.col_pos &&
+         a.piece == b.piece && a.rotation == b.rotation;
+}
+
+// The board rows covered by the cells of the tetramino, bit r for row r
+uint32_t TetraminoRows(const tetramino_t& tetramino) {
+  const figure_t* figure = tetramino_figure(&tetramino);
+  uint32_t rows = 0;
+  for (int i = 0; i < kNextFieldHeight; i++) {
+    if (figure->row_mask[tetramino.rotation][i] != 0) {
+      rows |= 1u << (tetramino.row_pos + i);
     }
   }
+  return rows;
+}
 
-  // deep copy of current tetramino
-  for (int i = 0; i < kNextFieldHeight; i++) {
-    for (int j = 0; j < kNextFieldWidth; j++) {
-      if (game_board->tetramino_curr.figure
-              .sprite[game_board->tetramino_curr.rotation][i][j] != 0) {
-        game_info->field[game_board->tetramino_curr.row_pos + i]
-                        [game_board->tetramino_curr.col_pos + j] =
-            game_board->tetramino_curr.figure.figure_color;
+}  // namespace
+
+void TetrisController::RenderField() {
+  const tetramino_t& curr = board->tetramino_curr;
+  uint32_t rows = drawn_ ? board->dirty_rows : board_t::kAllRowsMask;
+  board->dirty_rows = 0;
+  if (!drawn_ || !SameTetramino(curr, drawn_curr_)) {
+    rows |= TetraminoRows(curr);
+    if (drawn_) rows |= TetraminoRows(drawn_curr_);
+  }
+  drawn_curr_ = curr;
+
+  const figure_t* figure = tetramino_figure(&curr);
+  for (; rows != 0; rows &= rows - 1) {
+    int row = __builtin_ctz(rows);
+    int piece_row = row - curr.row_pos;
+    uint32_t piece = 0;
+    if (piece_row >= 0 && piece_row < kNextFieldHeight) {
+      piece = figure->row_mask[curr.rotation][piece_row];
+    }
+    for (int col = 0; col < kFieldWidth; col++) {
+      int color = board->board[row][col];
+      int piece_col = col - curr.col_pos;
+      if (piece_col >= 0 && piece_col < kNextFieldWidth &&
+          (piece & (1u << piece_col))) {
+        color = figure->figure_color;
+      }
+      if (game_info->field[row][col] != color) {
+        game_info->field[row][col] = color;
+        cell_diff_.Add(row, col, color);
       }
     }
   }
+}
+
+void TetrisController::RenderNext() {
+  const tetramino_t& next = board->tetramino_next;
+  if (drawn_ && SameTetramino(next, drawn_next_)) return;
+  drawn_next_ = next;
+  cell_diff_.next_changed = true;
 
-  // deep copy of next tetramino
+  const figure_t* next_figure = tetramino_figure(&next);
   for (int i = 0; i < kNextFieldHeight; i++) {
     for (int j = 0; j < kNextFieldWidth; j++) {
-      if (game_board->tetramino_next.figure
-              .sprite[game_board->tetramino_next.rotation][i][j] != 0) {
-        game_info->next[i][j] = game_board->tetramino_next.figure.figure_color;
+      if (next_figure->row_mask[next.rotation][i] & (1u << j)) {
+        game_info->next[i][j] = next_figure->figure_color;
       } else {
         game_info->next[i][j] = 0;
       }
     }
   }
-
-  return *game_info;
 }
 
-void userInput(UserAction_t action, [[maybe_unused]] bool hold) {
+void TetrisController::processUserInput(UserAction_t action,
+                                        [[maybe_unused]] bool hold) {
   signals sig;
   switch (action) {
     case UserAction_t::Start:
@@ -113,7 +146,7 @@ void userInput(UserAction_t action, [[maybe_unused]] bool hold) {
       sig = MOVE_RIGHT;
       break;
     case UserAction_t::Up:
-      sig = NOSIG;
+      sig = HARD_DROP;
       break;
     case UserAction_t::Down:
       sig = MOVE_DOWN;
@@ -122,11 +155,34 @@ void userInput(UserAction_t action, [[maybe_unused]] bool hold) {
       sig = NOSIG;
       break;
   }
-  sigact(
-      sig,
-      (dynamic_cast<s21::TetrisController*>(s21::Controller::instance))->state,
-      (dynamic_cast<s21::TetrisController*>(s21::Controller::instance))->stats,
-      (dynamic_cast<s21::TetrisController*>(s21::Controller::instance))->board);
+  sigact(sig, state, stats, board);
+}
 
-  return;
+int TetrisController::ConsumeGravityDrops() {
+  int drops = 0;
+  int gravity_delay_in_ticks = (500 - 35 * stats->level) / kTetrisTickInMs;
+  for (int ticks = timestep_.Consume(); ticks > 0; --ticks) {
+    if (++ticks_since_gravity_ > gravity_delay_in_ticks) {
+      ticks_since_gravity_ = 0;
+      drops++;
+    }
+  }
+  return drops;
+}
+}  // namespace s21
+
+GameInfo_t updateCurrentState() {
+  s21::TetrisController* controller = s21::TetrisController::Bound();
+  if (controller == nullptr) {
+    return GameInfo_t{};
+  }
+  controller->UpdateCurrentState();
+  return controller->GetGameInfo();
+}
+
+void userInput(UserAction_t action, bool hold) {
+  s21::TetrisController* controller = s21::TetrisController::Bound();
+  if (controller != nullptr) {
+    controller->processUserInput(action, hold);
+  }
 }
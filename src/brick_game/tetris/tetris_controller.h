@@ -1,26 +1,91 @@
 #ifndef TETRIS_CONTROLLER_H
 #define TETRIS_CONTROLLER_H
 
-#include <stdexcept>
-
 #include "../common.h"
 #include "../controller.h"
+#include "../game_clock.h"
 #include "fsm.h"
 #include "tetris_backend.h"
 
 namespace s21 {
 
+/**
+ * @brief The length of one fixed gravity tick of the tetris game in
+ * milliseconds. Gravity delays of every level are whole multiples of it.
+ */
+constexpr int kTetrisTickInMs = 5;
+
+/**
+ * @brief The largest number of gravity ticks simulated in one update.
+ */
+constexpr int kTetrisMaxCatchUpTicks = 1000 / kTetrisTickInMs;
+
+/**
+ * @brief Drives the C tetris backend for the views.
+ *
+ * Any number of controllers may exist, each driving its own board. The first
+ * one created is bound as a typed handle, see Bound(), which the
+ * `userInput()` and `updateCurrentState()` bridge functions use, so no call
+ * has to look the game up through the untyped `Controller::instance`. The
+ * others are driven through their own methods, e.g. by a GameLoop.
+ *
+ * The binding is process-wide and unsynchronized: create and destroy
+ * controllers on one thread.
+ */
 class TetrisController : public Controller {
  private:
+  static TetrisController* bound_;
+  FixedTimestep timestep_;
+  int ticks_since_gravity_ = 0;
+  CellDiff cell_diff_;
+  // The pieces drawn into the game info by the last update
+  tetramino_t drawn_curr_ = {};
+  tetramino_t drawn_next_ = {};
+  bool drawn_ = false;
+
+  void RenderField();
+  void RenderNext();
+
  public:
   GameInfo_t* game_info;
   game_state* state;
   board_t* board;
   game_stats_t* stats;
   TetrisController(GameInfo_t* game_info, game_state* state, board_t* board,
-                   game_stats_t* stats);
+                   game_stats_t* stats, GameClock* clock = nullptr);
+  /**
+   * @brief Unbinds the controller if it serves the bridge, so the next one
+   * created takes its place.
+   */
+  ~TetrisController() override;
+
+  TetrisController(const TetrisController&) = delete;
+  TetrisController& operator=(const TetrisController&) = delete;
+
+  /**
+   * @brief Returns the controller bound to the bridge, or nullptr.
+   */
+  static TetrisController* Bound() noexcept { return bound_; }
+
+  /**
+   * @brief Runs the gravity drops that came due and renders the board, the
+   * falling piece and the next piece into the game info.
+   *
+   * Only rows the backend marked dirty and the rows of a moved piece are
+   * rendered again; the cells that changed are listed in GetCellDiff().
+   */
   void UpdateCurrentState() override;
+  /**
+   * @brief Maps the action to a signal and feeds it to the state machine.
+   */
   void processUserInput(UserAction_t action, bool hold) override;
+  const GameInfo_t& GetGameInfo() const override { return *game_info; }
+  const CellDiff& GetCellDiff() const override { return cell_diff_; }
+  /**
+   * @brief Runs the gravity ticks that came due on the clock.
+   * @return The number of gravity drops the current piece should make.
+   */
+  int ConsumeGravityDrops();
 };
 }  // namespace s21
 
@@ -4,18 +4,24 @@
 
 #include "../common.h"
 
+/**
+ * @brief Owns the field and next-figure storage of a `GameInfo_t`.
+ *
+ * The cells of each grid live in one contiguous block and the `int**` rows
+ * of the `GameInfo_t` point into it, so the legacy layout costs no per-row
+ * allocations.
+ */
 class GameInfo {
  public:
   GameInfo() {
-    info_.field = new int*[kFieldHeight];
     for (int i = 0; i < kFieldHeight; i++) {
-      info_.field[i] = new int[kFieldWidth];
+      field_rows_[i] = &field_[i * kFieldWidth];
     }
-
-    info_.next = new int*[kNextFieldHeight];
     for (int i = 0; i < kNextFieldHeight; i++) {
-      info_.next[i] = new int[kNextFieldWidth];
+      next_rows_[i] = &next_[i * kNextFieldWidth];
     }
+    info_.field = field_rows_;
+    info_.next = next_rows_;
 
     info_.pause = 0;
     info_.score = 0;
@@ -24,21 +30,16 @@ class GameInfo {
     info_.speed = 1;
   }
 
-  ~GameInfo() {
-    for (int i = 0; i < kFieldHeight; i++) {
-      delete[] info_.field[i];
-    }
-    delete[] info_.field;
-
-    for (int i = 0; i < kNextFieldHeight; i++) {
-      delete[] info_.next[i];
-    }
-    delete[] info_.next;
-  }
+  GameInfo(const GameInfo&) = delete;
+  GameInfo& operator=(const GameInfo&) = delete;
 
   GameInfo_t* get() { return &info_; }
 
  private:
+  int field_[kFieldHeight * kFieldWidth] = {};
+  int next_[kNextFieldHeight * kNextFieldWidth] = {};
+  int* field_rows_[kFieldHeight] = {};
+  int* next_rows_[kNextFieldHeight] = {};
   GameInfo_t info_;
 };
 
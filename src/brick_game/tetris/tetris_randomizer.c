@@ -0,0 +1,70 @@
+#include "tetris_randomizer.h"
+
+static uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+static uint64_t splitmix64(uint64_t *x) {
+  uint64_t z = (*x += 0x9e3779b97f4a7c15ull);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+uint32_t randomizer_u32(randomizer_t *randomizer) {
+  uint32_t *s = randomizer->state;
+  uint32_t result = rotl(s[1] * 5, 7) * 9;
+  uint32_t t = s[1] << 9;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = rotl(s[3], 11);
+  return result;
+}
+
+/* Returns a value in [0, bound) by multiply-shift, avoiding the division of
+ * a modulo. */
+static uint32_t random_below(randomizer_t *randomizer, uint32_t bound) {
+  return (uint32_t)(((uint64_t)randomizer_u32(randomizer) * bound) >> 32);
+}
+
+static uint8_t draw_piece(randomizer_t *randomizer) {
+  if (randomizer->mode == RANDOMIZER_UNIFORM)
+    return (uint8_t)random_below(randomizer, TETRAMINOS);
+
+  if (randomizer->bag == 0) randomizer->bag = (1u << TETRAMINOS) - 1;
+  // Deal the i-th of the pieces left in the bag
+  uint32_t left = randomizer->bag;
+  for (uint32_t i = random_below(randomizer, __builtin_popcount(left)); i > 0;
+       --i)
+    left &= left - 1;
+  uint8_t piece = (uint8_t)__builtin_ctz(left);
+  randomizer->bag &= (uint8_t)~(1u << piece);
+  return piece;
+}
+
+void seed_randomizer(randomizer_t *randomizer, uint64_t seed,
+                     randomizer_mode_t mode) {
+  uint64_t a = splitmix64(&seed);
+  uint64_t b = splitmix64(&seed);
+  randomizer->state[0] = (uint32_t)a;
+  randomizer->state[1] = (uint32_t)(a >> 32);
+  randomizer->state[2] = (uint32_t)b;
+  randomizer->state[3] = (uint32_t)(b >> 32);
+  randomizer->mode = mode;
+  randomizer->bag = 0;
+  randomizer->queue_head = 0;
+  for (int i = 0; i < PIECE_QUEUE_SIZE; ++i)
+    randomizer->queue[i] = draw_piece(randomizer);
+}
+
+uint8_t randomizer_next(randomizer_t *randomizer) {
+  uint8_t piece = randomizer->queue[randomizer->queue_head];
+  randomizer->queue[randomizer->queue_head] = draw_piece(randomizer);
+  randomizer->queue_head = (randomizer->queue_head + 1) % PIECE_QUEUE_SIZE;
+  return piece;
+}
+
+uint8_t randomizer_peek(const randomizer_t *randomizer, int index) {
+  return randomizer->queue[(randomizer->queue_head + index) % PIECE_QUEUE_SIZE];
+}
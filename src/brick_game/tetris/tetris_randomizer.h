@@ -0,0 +1,71 @@
+#ifndef TETRIS_RANDOMIZER_H
+#define TETRIS_RANDOMIZER_H
+
+#include <stdint.h>
+
+#include "defines_tetris.h"
+
+/**
+ * Selects how the randomizer draws pieces.
+ *
+ * - RANDOMIZER_UNIFORM: Every piece is drawn independently and uniformly.
+ * - RANDOMIZER_BAG7: Pieces are dealt from shuffled bags holding each of the
+ *   seven pieces once, so no piece is missing for more than 12 draws and no
+ *   piece repeats more than twice in a row.
+ */
+typedef enum { RANDOMIZER_UNIFORM = 0, RANDOMIZER_BAG7 } randomizer_mode_t;
+
+/**
+ * Per-board piece randomizer: xoshiro128** generator state, the pieces left
+ * in the current bag (bit p for piece p) and a ring buffer with the next
+ * PIECE_QUEUE_SIZE pieces. `mode` holds a randomizer_mode_t.
+ *
+ * All state lives in the struct, so boards never share randomness and a
+ * board seeded with the same value always deals the same pieces. It is
+ * plain data of 24 bytes, copied as part of a game snapshot.
+ */
+typedef struct {
+  uint32_t state[4];
+  uint8_t mode;
+  uint8_t bag;
+  uint8_t queue[PIECE_QUEUE_SIZE];
+  uint8_t queue_head;
+} randomizer_t;
+
+/**
+ * Seeds the randomizer and fills its lookahead queue.
+ *
+ * @param randomizer Pointer to the randomizer to seed.
+ * @param seed Any 64-bit value; equal seeds give equal piece sequences.
+ * @param mode The drawing mode.
+ */
+void seed_randomizer(randomizer_t *randomizer, uint64_t seed,
+                     randomizer_mode_t mode);
+
+/**
+ * Takes the front piece from the lookahead queue and draws a new one to
+ * its back.
+ *
+ * @param randomizer Pointer to the randomizer.
+ * @return The piece index, less than TETRAMINOS.
+ */
+uint8_t randomizer_next(randomizer_t *randomizer);
+
+/**
+ * Returns a queued piece without taking it.
+ *
+ * @param randomizer Pointer to the randomizer.
+ * @param index Position in the queue, 0 being the piece that comes next.
+ * @return The piece index, less than TETRAMINOS.
+ */
+uint8_t randomizer_peek(const randomizer_t *randomizer, int index);
+
+/**
+ * Returns the next raw 32-bit output of the randomizer's generator.
+ *
+ * @param randomizer Pointer to the randomizer.
+ * @return A uniformly distributed 32-bit value.
+ */
+uint32_t randomizer_u32(randomizer_t *randomizer);
+
+#endif
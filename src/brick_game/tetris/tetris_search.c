@@ -0,0 +1,313 @@
+#include "tetris_search.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+const heuristic_weights_t default_heuristic_weights = {
+    .aggregate_height = -0.510066,
+    .holes = -0.35663,
+    .bumpiness = -0.184483,
+    .lines_cleared = 0.760666,
+};
+
+/* Breadth-first search over piece positions. A position is stored by its
+ * index (rotation, row, column), with the move that first reached it. */
+template <int Rows, int Cols>
+struct search_t {
+  /* Rows and columns a piece position can take, see search_states */
+  static constexpr int kRows = Rows + 2;
+  static constexpr int kCols = Cols + 3;
+  static constexpr int kStates = search_states<Rows, Cols>;
+  static_assert(kStates <= INT16_MAX, "positions are stored as int16_t");
+
+  int16_t parent[kStates];
+  int8_t move[kStates];
+  int16_t queue[kStates];
+  int count;
+};
+
+template <int Rows, int Cols>
+static int state_index(const tetramino_t *t) {
+  typedef search_t<Rows, Cols> search;
+  return (t->rotation * search::kRows + t->row_pos + 2) * search::kCols +
+         t->col_pos + 3;
+}
+
+template <int Rows, int Cols>
+static void state_position(int index, tetramino_t *t) {
+  typedef search_t<Rows, Cols> search;
+  t->col_pos = index % search::kCols - 3;
+  index /= search::kCols;
+  t->row_pos = index % search::kRows - 2;
+  t->rotation = index / search::kRows;
+}
+
+template <int Rows, int Cols>
+static bool fits(const basic_board_t<Rows, Cols> *board, const tetramino_t *t) {
+  return !check_lborder_collide(t) && !check_rborder_collide<Cols>(t) &&
+         !check_board_collide(t, board);
+}
+
+/* Applies a move the way fsm.c does; returns false if the game would refuse
+ * it. */
+template <int Rows, int Cols>
+static bool try_move(const basic_board_t<Rows, Cols> *board, signals move,
+                     tetramino_t *t) {
+  switch (move) {
+    case MOVE_LEFT:
+      t->col_pos--;
+      return fits(board, t);
+    case MOVE_RIGHT:
+      t->col_pos++;
+      return fits(board, t);
+    case MOVE_DOWN:
+      t->row_pos++;
+      return !check_board_collide(t, board);
+    case ACTION_BTN:
+      return rotate_tetramino(board, t);
+    default:
+      return false;
+  }
+}
+
+template <int Rows, int Cols>
+static void search_positions(const basic_board_t<Rows, Cols> *board,
+                             const tetramino_t *piece,
+                             search_t<Rows, Cols> *search) {
+  static const signals moves[] = {MOVE_LEFT, MOVE_RIGHT, MOVE_DOWN,
+                                  ACTION_BTN};
+  memset(search->parent, 0xff, sizeof(search->parent));
+  search->count = 0;
+  if (!fits(board, piece)) return;
+
+  int start = state_index<Rows, Cols>(piece);
+  search->parent[start] = (int16_t)start;
+  search->queue[search->count++] = (int16_t)start;
+  for (int head = 0; head < search->count; ++head) {
+    int from = search->queue[head];
+    for (int i = 0; i < 4; ++i) {
+      tetramino_t t = *piece;
+      state_position<Rows, Cols>(from, &t);
+      if (!try_move(board, moves[i], &t)) continue;
+      int to = state_index<Rows, Cols>(&t);
+      if (search->parent[to] >= 0) continue;
+      search->parent[to] = (int16_t)from;
+      search->move[to] = (int8_t)moves[i];
+      search->queue[search->count++] = (int16_t)to;
+    }
+  }
+}
+
+/* Returns the sprite rows of a rotation moved to the top left corner of the
+ * sprite, as one mask with four bits per row. */
+static uint16_t packed_shape(const figure_t *figure, int rotation) {
+  const uint16_t *rows = figure->row_mask[rotation];
+  int first_row = 0;
+  while (rows[first_row] == 0) ++first_row;
+  int first_col = __builtin_ctz(figure->col_mask[rotation]);
+  uint16_t shape = 0;
+  for (int i = first_row; i < 4; ++i)
+    shape |= (uint16_t)((rows[i] >> first_col) << (4 * (i - first_row)));
+  return shape;
+}
+
+/* Moves a piece to the first rotation with the same shape, and to the
+ * position where it fills the same cells. Two rotations that look the same
+ * would otherwise give every placement twice. */
+static void canonical_footprint(tetramino_t *t) {
+  const figure_t *figure = tetramino_figure(t);
+  const uint16_t shape = packed_shape(figure, t->rotation);
+  for (int rotation = 0; rotation < t->rotation; ++rotation) {
+    if (packed_shape(figure, rotation) != shape) continue;
+    int first_row = 0;
+    int first_row_to = 0;
+    while (figure->row_mask[t->rotation][first_row] == 0) ++first_row;
+    while (figure->row_mask[rotation][first_row_to] == 0) ++first_row_to;
+    t->row_pos += first_row - first_row_to;
+    t->col_pos += __builtin_ctz(figure->col_mask[t->rotation]) -
+                  __builtin_ctz(figure->col_mask[rotation]);
+    t->rotation = rotation;
+    return;
+  }
+}
+
+template <int Rows, int Cols>
+int find_placements(const basic_board_t<Rows, Cols> *board,
+                    const tetramino_t *piece, placement_t *placements) {
+  search_t<Rows, Cols> search;
+  search_positions(board, piece, &search);
+
+  // Placements filling the same cells are listed once, in the rotation the
+  // search reached first
+  bool listed[search_t<Rows, Cols>::kStates] = {};
+  int count = 0;
+  for (int i = 0; i < search.count; ++i) {
+    tetramino_t t = *piece;
+    state_position<Rows, Cols>(search.queue[i], &t);
+    t.row_pos++;
+    if (check_board_collide(&t, board)) {
+      t.row_pos--;
+      tetramino_t footprint = t;
+      canonical_footprint(&footprint);
+      bool *seen = &listed[state_index<Rows, Cols>(&footprint)];
+      if (*seen) continue;
+      *seen = true;
+      placements[count].tetramino = t;
+      placements[count].score = 0;
+      count++;
+    }
+  }
+  return count;
+}
+
+template <int Rows, int Cols>
+void evaluate_placement(const basic_board_t<Rows, Cols> *board,
+                        const tetramino_t *final,
+                        placement_features_t *features) {
+  typedef typename basic_board_t<Rows, Cols>::row_mask_t row_mask_t;
+  const row_mask_t full_row = basic_board_t<Rows, Cols>::kFullRowMask;
+  const figure_t *figure = tetramino_figure(final);
+  row_mask_t rows[Rows];
+  memcpy(rows, board->rows, sizeof(rows));
+  for (int i = 0; i < 4; ++i) {
+    uint16_t piece = figure->row_mask[final->rotation][i];
+    if (piece == 0) continue;
+    rows[final->row_pos + i] |= (row_mask_t)(
+        ((uint64_t)piece << (final->col_pos + MASK_COL_OFFSET)) >>
+        MASK_COL_OFFSET);
+  }
+
+  // Drop the full rows, packing the rest to the bottom
+  int top = Rows;
+  for (int row = Rows - 1; row >= 0; --row)
+    if (rows[row] != full_row) rows[--top] = rows[row];
+
+  memset(features, 0, sizeof(*features));
+  features->lines_cleared = top;
+  while (top < Rows && rows[top] == 0) ++top;
+  int heights[Cols] = {0};
+  uint32_t seen = 0;
+  for (int row = top; row < Rows; ++row) {
+    features->holes += __builtin_popcount(seen & ~rows[row] & full_row);
+    uint32_t fresh = rows[row] & ~seen;
+    seen |= rows[row];
+    while (fresh != 0) {
+      int col = __builtin_ctz(fresh);
+      heights[col] = Rows - row;
+      features->aggregate_height += Rows - row;
+      fresh &= fresh - 1;
+    }
+  }
+  for (int col = 0; col < Cols; ++col) {
+    if (heights[col] > features->max_height)
+      features->max_height = heights[col];
+    if (col > 0) features->bumpiness += abs(heights[col] - heights[col - 1]);
+  }
+}
+
+double weighted_heuristic(const placement_features_t *features,
+                          const void *context) {
+  const heuristic_weights_t *weights = (const heuristic_weights_t *)context;
+  return weights->aggregate_height * features->aggregate_height +
+         weights->holes * features->holes +
+         weights->bumpiness * features->bumpiness +
+         weights->lines_cleared * features->lines_cleared;
+}
+
+template <int Rows, int Cols>
+int find_best_placement(const basic_board_t<Rows, Cols> *board,
+                        const tetramino_t *piece,
+                        placement_heuristic_t heuristic, const void *context,
+                        placement_t *best) {
+  placement_t placements[search_states<Rows, Cols>];
+  int count = find_placements(board, piece, placements);
+  for (int i = 0; i < count; ++i) {
+    placement_t *placement = &placements[i];
+    evaluate_placement(board, &placement->tetramino, &placement->features);
+    placement->score = heuristic(&placement->features, context);
+    if (i == 0 || placement->score > best->score) *best = *placement;
+  }
+  return count;
+}
+
+template <int Rows, int Cols>
+int plan_placement_moves(const basic_board_t<Rows, Cols> *board,
+                         const tetramino_t *piece, const tetramino_t *target,
+                         signals *moves) {
+  search_t<Rows, Cols> search;
+  search_positions(board, piece, &search);
+
+  int start = state_index<Rows, Cols>(piece);
+  int index = state_index<Rows, Cols>(target);
+  if (target->piece != piece->piece || search.parent[index] < 0) return -1;
+
+  int count = 0;
+  for (; index != start; index = search.parent[index])
+    moves[count++] = (signals)search.move[index];
+  for (int i = 0; i < count / 2; ++i) {
+    signals tmp = moves[i];
+    moves[i] = moves[count - 1 - i];
+    moves[count - 1 - i] = tmp;
+  }
+  return count;
+}
+
+template <int Rows, int Cols>
+int autoplay_piece(basic_board_t<Rows, Cols> *board,
+                   placement_heuristic_t heuristic, const void *context,
+                   placement_t *best) {
+  board->tetramino_curr = board->tetramino_next;
+  board->tetramino_next = gen_next_tetramino(board);
+  if (check_board_collide(&board->tetramino_curr, board)) return 0;
+
+  int count = find_best_placement(board, &board->tetramino_curr, heuristic,
+                                  context, best);
+  if (count == 0) return 0;
+  board->tetramino_curr = best->tetramino;
+  attach_tetramino(board);
+  board->cleared_rows = clear_full_rows(board, best->tetramino.row_pos);
+  return count;
+}
+
+template <int Rows, int Cols>
+autoplay_result_t play_seeded_game(basic_board_t<Rows, Cols> *board,
+                                   uint64_t seed, long max_pieces,
+                                   placement_heuristic_t heuristic,
+                                   const void *context) {
+  autoplay_result_t result = {.pieces = 0, .lines = 0, .placements = 0};
+  init_board_seeded(board, seed, RANDOMIZER_BAG7);
+  placement_t best;
+  while (result.pieces < max_pieces) {
+    int count = autoplay_piece(board, heuristic, context, &best);
+    if (count == 0) break;
+    result.placements += count;
+    result.lines += __builtin_popcountll(board->cleared_rows);
+    result.pieces++;
+  }
+  return result;
+}
+
+/* The board sizes the game logic is compiled for, see board_t. */
+#define INSTANTIATE_SEARCH_FUNCTIONS(Board)                                   \
+  template int find_placements(const Board *board, const tetramino_t *piece, \
+                               placement_t *placements);                     \
+  template void evaluate_placement(const Board *board,                        \
+                                   const tetramino_t *final,                  \
+                                   placement_features_t *features);           \
+  template int find_best_placement(                                           \
+      const Board *board, const tetramino_t *piece,                           \
+      placement_heuristic_t heuristic, const void *context,                   \
+      placement_t *best);                                                     \
+  template int plan_placement_moves(const Board *board,                       \
+                                    const tetramino_t *piece,                 \
+                                    const tetramino_t *target,                \
+                                    signals *moves);                          \
+  template int autoplay_piece(Board *board, placement_heuristic_t heuristic,  \
+                              const void *context, placement_t *best);        \
+  template autoplay_result_t play_seeded_game(                                \
+      Board *board, uint64_t seed, long max_pieces,                           \
+      placement_heuristic_t heuristic, const void *context);
+
+INSTANTIATE_SEARCH_FUNCTIONS(board_t)
+INSTANTIATE_SEARCH_FUNCTIONS(tall_board_t)
+INSTANTIATE_SEARCH_FUNCTIONS(square_board_t)
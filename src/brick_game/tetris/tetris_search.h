@@ -0,0 +1,190 @@
+#ifndef TETRIS_SEARCH_H
+#define TETRIS_SEARCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "defines_tetris.h"
+#include "fsm.h"
+#include "objects.h"
+
+/* Number of distinct piece positions (rotation, row, column) on a board.
+ * A 4x4 sprite may start up to three columns left of the board, and up to two
+ * rows above it, as the top two rows of a sprite may be empty. */
+template <int Rows, int Cols>
+constexpr int search_states = 4 * (Rows + 2) * (Cols + 3);
+/* Number of piece positions on board_t */
+#define SEARCH_STATES (search_states<BOARD_ROWS, BOARD_COLS>)
+
+/**
+ * Describes the board after a piece is locked and the full rows are cleared.
+ *
+ * - aggregate_height: The sum of all column heights.
+ * - holes: Empty cells with a filled cell somewhere above them.
+ * - bumpiness: The sum of height differences of adjacent columns.
+ * - lines_cleared: The number of rows the piece completed.
+ * - max_height: The height of the highest column.
+ */
+typedef struct {
+  int aggregate_height;
+  int holes;
+  int bumpiness;
+  int lines_cleared;
+  int max_height;
+} placement_features_t;
+
+/**
+ * A final resting position of a piece, with the board features it leads to
+ * and their heuristic score.
+ */
+typedef struct {
+  tetramino_t tetramino;
+  placement_features_t features;
+  double score;
+} placement_t;
+
+/**
+ * Rates a placement from its features; higher is better.
+ *
+ * @param features The board features after the placement.
+ * @param context Data the heuristic was registered with, e.g. its weights.
+ * @return The score of the placement.
+ */
+typedef double (*placement_heuristic_t)(const placement_features_t *features,
+                                        const void *context);
+
+/**
+ * Weights of the linear heuristic, one per feature.
+ */
+typedef struct {
+  double aggregate_height;
+  double holes;
+  double bumpiness;
+  double lines_cleared;
+} heuristic_weights_t;
+
+/**
+ * Weights that clear lines steadily on a 10x20 board.
+ */
+extern const heuristic_weights_t default_heuristic_weights;
+
+/**
+ * The linear heuristic: the weighted sum of the features.
+ *
+ * @param features The board features after the placement.
+ * @param context Pointer to a heuristic_weights_t.
+ * @return The score of the placement.
+ */
+double weighted_heuristic(const placement_features_t *features,
+                          const void *context);
+
+/**
+ * Enumerates every final placement the piece can reach from its current
+ * position with the game's moves: left, right, rotate and soft drop. Tucks
+ * and spins under overhangs are included; each placement is listed once,
+ * also when two rotations of the piece fill the same cells.
+ *
+ * @param board The board to place on; only its cells are used.
+ * @param piece The piece at its current position.
+ * @param placements Output array of at least search_states<Rows, Cols>
+ * entries, filled with the final positions. Features and scores are not set.
+ * @return The number of placements, 0 if the piece cannot move at all.
+ */
+template <int Rows, int Cols>
+int find_placements(const basic_board_t<Rows, Cols> *board,
+                    const tetramino_t *piece, placement_t *placements);
+
+/**
+ * Computes the board features after locking @p final on @p board.
+ *
+ * @param board The board before the piece is locked.
+ * @param final The piece at its resting position.
+ * @param features Output features.
+ */
+template <int Rows, int Cols>
+void evaluate_placement(const basic_board_t<Rows, Cols> *board,
+                        const tetramino_t *final,
+                        placement_features_t *features);
+
+/**
+ * Finds the reachable placement with the highest heuristic score.
+ *
+ * @param board The board to place on.
+ * @param piece The piece at its current position.
+ * @param heuristic The rating function.
+ * @param context Data passed to @p heuristic.
+ * @param best Output, the best placement with its features and score.
+ * @return The number of placements evaluated, 0 if there is none.
+ */
+template <int Rows, int Cols>
+int find_best_placement(const basic_board_t<Rows, Cols> *board,
+                        const tetramino_t *piece,
+                        placement_heuristic_t heuristic, const void *context,
+                        placement_t *best);
+
+/**
+ * Plans the input signals that move the piece from its current position to
+ * @p target, which must be one of the placements found for it. Sending the
+ * signals, then MOVE_DOWN to lock, places the piece in the running game.
+ *
+ * @param board The board to place on.
+ * @param piece The piece at its current position.
+ * @param target The final position to reach.
+ * @param moves Output array of at least search_states<Rows, Cols> signals.
+ * @return The number of signals, or -1 if @p target is not reachable.
+ */
+template <int Rows, int Cols>
+int plan_placement_moves(const basic_board_t<Rows, Cols> *board,
+                         const tetramino_t *piece, const tetramino_t *target,
+                         signals *moves);
+
+/**
+ * Totals of an autoplayed game.
+ *
+ * - pieces: The number of pieces locked.
+ * - lines: The number of rows cleared.
+ * - placements: The number of placements the search evaluated.
+ */
+typedef struct {
+  long pieces;
+  long lines;
+  long placements;
+} autoplay_result_t;
+
+/**
+ * Deals the next piece and locks it at the best placement for @p heuristic,
+ * clearing the rows it completes. This is one piece through the spawn,
+ * moving and attaching states, without the clock or the input signals.
+ *
+ * @param board The board to play on.
+ * @param heuristic The rating function.
+ * @param context Data passed to @p heuristic.
+ * @param best Output, the placement the piece was locked at; its features
+ * hold the number of rows it cleared.
+ * @return The number of placements evaluated, 0 if the game is over because
+ * the piece has no room to spawn or nowhere to go.
+ */
+template <int Rows, int Cols>
+int autoplay_piece(basic_board_t<Rows, Cols> *board,
+                   placement_heuristic_t heuristic, const void *context,
+                   placement_t *best);
+
+/**
+ * Seeds @p board with the 7-bag randomizer and autoplays it until the stack
+ * tops out or @p max_pieces pieces are locked. Games use no clock and no
+ * shared state, so they run at full speed on any thread.
+ *
+ * @param board The board to play on.
+ * @param seed The randomizer seed; equal seeds play equal games.
+ * @param max_pieces The number of pieces after which the game stops.
+ * @param heuristic The rating function.
+ * @param context Data passed to @p heuristic.
+ * @return The totals of the game.
+ */
+template <int Rows, int Cols>
+autoplay_result_t play_seeded_game(basic_board_t<Rows, Cols> *board,
+                                   uint64_t seed, long max_pieces,
+                                   placement_heuristic_t heuristic,
+                                   const void *context);
+
+#endif
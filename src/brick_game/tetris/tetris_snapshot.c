@@ -0,0 +1,80 @@
+#include "tetris_snapshot.h"
+
+#include <string.h>
+
+#include <type_traits>
+
+static_assert(sizeof(tetris_snapshot_t) <= 128,
+              "a snapshot must stay within two cache lines");
+static_assert(std::is_trivially_copyable<tetris_snapshot_t>::value,
+              "a snapshot must be copyable with memcpy");
+static_assert(BOARD_COLS * 3 <= 32 && kColorWhite < 8,
+              "a board row of colors must pack into 32 bits");
+
+void save_snapshot(const board_t *board, const game_stats_t *stats,
+                   game_state state, tetris_snapshot_t *snapshot) {
+  memcpy(snapshot->rows, board->rows, sizeof(snapshot->rows));
+  memcpy(snapshot->heights, board->heights, sizeof(snapshot->heights));
+  memcpy(snapshot->holes, board->holes, sizeof(snapshot->holes));
+  snapshot->cleared_rows = board->cleared_rows;
+  snapshot->tetramino_curr = board->tetramino_curr;
+  snapshot->tetramino_next = board->tetramino_next;
+  snapshot->randomizer = board->randomizer;
+  snapshot->next_advance_time_in_ms = stats->next_advance_time_in_ms;
+  snapshot->score = stats->score;
+  snapshot->high_score = stats->high_score;
+  snapshot->level = (int8_t)stats->level;
+  snapshot->state = (uint8_t)state;
+}
+
+void save_colors(const board_t *board, tetris_colors_t *colors) {
+  for (int row = 0; row < BOARD_ROWS; ++row) {
+    uint32_t packed = 0;
+    for (int col = BOARD_COLS - 1; col >= 0; --col)
+      packed = packed << 3 | (uint32_t)board->board[row][col];
+    colors->rows[row] = packed;
+  }
+}
+
+/* Repaints one board row from its packed colors, marking it dirty if a cell
+ * changed. */
+static void restore_row_colors(uint32_t packed, board_t *board, int row) {
+  bool changed = false;
+  for (int col = 0; col < BOARD_COLS; ++col, packed >>= 3) {
+    int color = (int)(packed & 7);
+    if (board->board[row][col] == color) continue;
+    board->board[row][col] = color;
+    changed = true;
+  }
+  if (changed) board->dirty_rows |= 1u << row;
+}
+
+void restore_snapshot(const tetris_snapshot_t *snapshot,
+                      const tetris_colors_t *colors, board_t *board,
+                      game_stats_t *stats, game_state *state) {
+  for (int row = 0; row < BOARD_ROWS; ++row) {
+    if (colors != NULL) {
+      restore_row_colors(colors->rows[row], board, row);
+      continue;
+    }
+    uint16_t changed = board->rows[row] ^ snapshot->rows[row];
+    if (changed != 0) board->dirty_rows |= 1u << row;
+    for (; changed != 0; changed &= changed - 1) {
+      int col = __builtin_ctz(changed);
+      board->board[row][col] =
+          (snapshot->rows[row] >> col) & 1 ? kColorWhite : kColorBlack;
+    }
+  }
+  memcpy(board->rows, snapshot->rows, sizeof(board->rows));
+  memcpy(board->heights, snapshot->heights, sizeof(board->heights));
+  memcpy(board->holes, snapshot->holes, sizeof(board->holes));
+  board->cleared_rows = snapshot->cleared_rows;
+  board->tetramino_curr = snapshot->tetramino_curr;
+  board->tetramino_next = snapshot->tetramino_next;
+  board->randomizer = snapshot->randomizer;
+  stats->next_advance_time_in_ms = snapshot->next_advance_time_in_ms;
+  stats->score = snapshot->score;
+  stats->high_score = snapshot->high_score;
+  stats->level = snapshot->level;
+  *state = (game_state)snapshot->state;
+}
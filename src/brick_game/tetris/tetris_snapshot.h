@@ -0,0 +1,85 @@
+#ifndef TETRIS_SNAPSHOT_H
+#define TETRIS_SNAPSHOT_H
+
+#include <stdint.h>
+
+#include "fsm.h"
+#include "objects.h"
+
+/**
+ * The complete logical state of a tetris game in plain data: the row bitmask
+ * board with its column cache, both pieces, the randomizer and the stats.
+ *
+ * It holds no pointers and fits in 128 bytes, so taking one is a single copy.
+ * Undo stacks and search trees can keep as many as they like and restore any
+ * of them in any order.
+ *
+ * The color grid of board_t is not part of a snapshot. It only serves
+ * rendering; keep a tetris_colors_t next to the snapshot where the restored
+ * board is drawn, see restore_snapshot().
+ */
+typedef struct {
+  uint16_t rows[BOARD_ROWS];
+  uint8_t heights[BOARD_COLS];
+  uint8_t holes[BOARD_COLS];
+  uint32_t cleared_rows;
+  tetramino_t tetramino_curr;
+  tetramino_t tetramino_next;
+  randomizer_t randomizer;
+  uint64_t next_advance_time_in_ms;
+  int32_t score;
+  int32_t high_score;
+  int8_t level;
+  uint8_t state;
+} tetris_snapshot_t;
+
+/**
+ * The color grid of a board_t, packed three bits per cell: bits 3c to 3c+2
+ * of `rows[r]` hold the color of row r, column c.
+ *
+ * An undo stack the player sees keeps one next to each snapshot, so undone
+ * cells get their piece colors back. Search trees that never draw the board
+ * can do without.
+ */
+typedef struct {
+  uint32_t rows[BOARD_ROWS];
+} tetris_colors_t;
+
+/**
+ * Captures the game state.
+ *
+ * @param board The game board.
+ * @param stats The game statistics.
+ * @param state The state of the game state machine.
+ * @param snapshot Output snapshot.
+ */
+void save_snapshot(const board_t *board, const game_stats_t *stats,
+                   game_state state, tetris_snapshot_t *snapshot);
+
+/**
+ * Captures the color grid of the board.
+ *
+ * @param board The game board.
+ * @param colors Output colors.
+ */
+void save_colors(const board_t *board, tetris_colors_t *colors);
+
+/**
+ * Puts the game back into a captured state.
+ *
+ * With @p colors, every cell gets its captured color back. Without them,
+ * cells filled in both the snapshot and the current board keep their color,
+ * and cells the snapshot brings back, such as rows removed by a clear since,
+ * are painted white.
+ *
+ * @param snapshot The snapshot to restore.
+ * @param colors The colors captured with the snapshot, or NULL.
+ * @param board Output game board.
+ * @param stats Output game statistics.
+ * @param state Output state of the game state machine.
+ */
+void restore_snapshot(const tetris_snapshot_t *snapshot,
+                      const tetris_colors_t *colors, board_t *board,
+                      game_stats_t *stats, game_state *state);
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace s21 {
+
+/**
+ * @brief Hands whole values from one writer thread to one reader thread
+ * without locks.
+ *
+ * Of the three slots the writer owns one (the back slot), the reader owns
+ * one (the front slot) and the third holds the newest published value. Both
+ * sides trade their slot for the middle one with a single atomic exchange,
+ * so neither ever waits for the other and the reader always sees a complete
+ * value. Values the reader did not pick up in time are overwritten.
+ *
+ * @tparam T The value type; it is written in place and never copied.
+ */
+template <class T>
+class TripleBuffer {
+ public:
+  /**
+   * @brief The slot the writer fills next. Writer thread only.
+   */
+  T &Back() { return slots_[back_]; }
+
+  /**
+   * @brief Makes the back slot the newest value and takes over the slot it
+   * replaces. Writer thread only.
+   */
+  void Publish() {
+    back_ = middle_.exchange(back_ | kFresh, std::memory_order_acq_rel) &
+            kIndexMask;
+  }
+
+  /**
+   * @brief Returns true while the newest published value has not been taken
+   * by the reader. Writer thread only.
+   *
+   * The reader may take it right after the check, so a true result is only a
+   * hint that the value may still be skipped.
+   */
+  bool Pending() const {
+    return (middle_.load(std::memory_order_acquire) & kFresh) != 0;
+  }
+
+  /**
+   * @brief Returns the newest published value. Reader thread only.
+   *
+   * The value stays valid and unchanged until the next call.
+   */
+  const T &Front() {
+    if (middle_.load(std::memory_order_relaxed) & kFresh) {
+      front_ = middle_.exchange(front_, std::memory_order_acq_rel) &
+               kIndexMask;
+    }
+    return slots_[front_];
+  }
+
+ private:
+  static constexpr uint8_t kIndexMask = 0x3;
+  // Set on the middle index while it holds a value the reader has not taken
+  static constexpr uint8_t kFresh = 0x4;
+  static constexpr std::size_t kCacheLine = 64;
+
+  std::array<T, 3> slots_{};
+  alignas(kCacheLine) std::atomic<uint8_t> middle_{1};
+  alignas(kCacheLine) uint8_t back_ = 0;
+  alignas(kCacheLine) uint8_t front_ = 2;
+};
+
+}  // namespace s21
+
+#endif  // TRIPLE_BUFFER_H
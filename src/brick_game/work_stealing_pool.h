@@ -0,0 +1,158 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @brief Fixed-size thread pool where idle workers steal queued tasks from
+ * busy ones.
+ *
+ * Every worker owns a task deque. Submitted tasks are dealt round-robin to
+ * the workers; a worker runs its own tasks newest-first and, once its deque is
+ * empty, takes the oldest task of another worker. This keeps all cores busy
+ * when task durations vary a lot, as they do for games of different length.
+ */
+class WorkStealingPool {
+ public:
+  using Task = std::function<void()>;
+
+  /**
+   * @brief Starts the worker threads.
+   * @param thread_count The number of workers, or 0 for one per core.
+   */
+  explicit WorkStealingPool(std::size_t thread_count = 0) {
+    if (thread_count == 0) {
+      thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (std::size_t i = 0; i < thread_count; ++i) {
+      queues_.push_back(std::make_unique<TaskQueue>());
+    }
+    for (std::size_t i = 0; i < thread_count; ++i) {
+      threads_.emplace_back([this, i] { RunWorker(i); });
+    }
+  }
+
+  /**
+   * @brief Finishes all submitted tasks and joins the workers.
+   */
+  ~WorkStealingPool() {
+    Wait();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    work_available_.notify_all();
+    for (auto &thread : threads_) {
+      thread.join();
+    }
+  }
+
+  WorkStealingPool(const WorkStealingPool &) = delete;
+  WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+  std::size_t Size() const noexcept { return threads_.size(); }
+
+  /**
+   * @brief Queues a task for execution on one of the workers.
+   */
+  void Submit(Task task) {
+    std::size_t target = next_queue_.fetch_add(1) % queues_.size();
+    // Count the task before a worker can see it, so finishing it can never
+    // take the counters below zero
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++queued_;
+      ++unfinished_;
+    }
+    {
+      std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+      queues_[target]->tasks.push_back(std::move(task));
+    }
+    work_available_.notify_one();
+  }
+
+  /**
+   * @brief Blocks until every submitted task has finished.
+   */
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    all_done_.wait(lock, [this] { return unfinished_ == 0; });
+  }
+
+ private:
+  struct TaskQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  bool PopOwn(std::size_t self, Task &task) {
+    std::lock_guard<std::mutex> lock(queues_[self]->mutex);
+    if (queues_[self]->tasks.empty()) {
+      return false;
+    }
+    task = std::move(queues_[self]->tasks.back());
+    queues_[self]->tasks.pop_back();
+    return true;
+  }
+
+  bool Steal(std::size_t self, Task &task) {
+    for (std::size_t offset = 1; offset < queues_.size(); ++offset) {
+      TaskQueue &victim = *queues_[(self + offset) % queues_.size()];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.tasks.empty()) {
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void RunWorker(std::size_t self) {
+    while (true) {
+      Task task;
+      if (PopOwn(self, task) || Steal(self, task)) {
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          --queued_;
+        }
+        task();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--unfinished_ == 0) {
+          all_done_.notify_all();
+        }
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_available_.wait(lock, [this] { return stop_ || queued_ > 0; });
+      if (stop_ && queued_ == 0) {
+        return;
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<TaskQueue>> queues_;
+  std::vector<std::thread> threads_;
+  std::atomic<std::size_t> next_queue_{0};
+  std::mutex mutex_;
+  std::condition_variable work_available_;
+  std::condition_variable all_done_;
+  std::size_t queued_ = 0;
+  std::size_t unfinished_ = 0;
+  bool stop_ = false;
+};
+
+}  // namespace s21
+
+#endif  // WORK_STEALING_POOL_H
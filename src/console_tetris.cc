@@ -6,7 +6,15 @@
 int main() {
   GameInfo game_info;
 
-  board_t board = {.board = {}, .tetramino_curr = {}, .tetramino_next = {}};
+  board_t board = {.board = {},
+                   .rows = {},
+                   .heights = {},
+                   .holes = {},
+                   .cleared_rows = 0,
+                   .dirty_rows = 0,
+                   .tetramino_curr = {},
+                   .tetramino_next = {},
+                   .randomizer = {}};
   init_board(&board);
 
   game_stats_t stats;
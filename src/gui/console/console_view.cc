@@ -1,6 +1,12 @@
 #include "console_view.h"
 
+#include <poll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <thread>
 
 namespace s21 {
 
@@ -51,8 +57,10 @@ void BrickGameConsoleView::PrintFrame(int top_y, int bottom_y, int left_x,
   s21::NCursesWrapper::ncAddWChar(bottom_y, i, ACS_LRCORNER);
 }
 
-void BrickGameConsoleView::PrintGameBoard(const GameInfo_t &current_game_info) {
-  for (int i = 0; i < kBoardRows; ++i)
+void BrickGameConsoleView::PrintGameBoard(
+    const GameSnapshot &current_game_info, uint32_t rows) {
+  for (int i = 0; i < kBoardRows; ++i) {
+    if (!(rows & (uint32_t{1} << i))) continue;
     for (int j = 0; j < kBoardCols; ++j) {
       s21::NcColorPairs color =
           static_cast<s21::NcColorPairs>(current_game_info.field[i][j]);
@@ -63,11 +71,12 @@ void BrickGameConsoleView::PrintGameBoard(const GameInfo_t &current_game_info) {
                                       kBoardOffset + 2 * j + 1, kEmptyPixel);
       attroff(COLOR_PAIR(color));
     }
+  }
 }
 
 void BrickGameConsoleView::PrintNextFigure(
-    const GameInfo_t &current_game_info) {
-  if (current_game_info.next == nullptr) {
+    const GameSnapshot &current_game_info) {
+  if (!current_game_info.has_next) {
     return;
   }
   for (int i = 0; i < 4; ++i) {
@@ -84,7 +93,8 @@ void BrickGameConsoleView::PrintNextFigure(
   }
 }
 
-void BrickGameConsoleView::PrintStats(const GameInfo_t &current_game_info) {
+void BrickGameConsoleView::PrintStats(
+    const GameSnapshot &current_game_info) {
   s21::NCursesWrapper::ncPrintW(
       2, kBoardM + 12, "%d",
       current_game_info.level > 0 ? current_game_info.level : 0);
@@ -101,9 +111,8 @@ void BrickGameConsoleView::PrintBanner(std::string &&banner_text) {
                                 banner_text.c_str());
 }
 
-std::optional<UserAction_t> BrickGameConsoleView::GetUserInput() {
+std::optional<UserAction_t> BrickGameConsoleView::KeyToAction(int ch) {
   std::optional<UserAction_t> input;
-  int ch = getch();
   switch (ch) {
     case 's':
       input = UserAction_t::Start;
@@ -136,39 +145,72 @@ std::optional<UserAction_t> BrickGameConsoleView::GetUserInput() {
   return input;
 }
 
+void BrickGameConsoleView::ReadInput(GameLoop &game_loop) {
+  pollfd stdin_fd = {.fd = STDIN_FILENO, .events = POLLIN, .revents = 0};
+  while (running.load(std::memory_order_relaxed)) {
+    // Waits outside the curses lock, so the render loop can draw meanwhile
+    if (poll(&stdin_fd, 1, kFrameInMs) <= 0) continue;
+    std::lock_guard<std::mutex> lock(curses_mutex);
+    for (int ch = getch(); ch != ERR; ch = getch()) {
+      auto action = KeyToAction(ch);
+      if (!action) continue;
+      if (action.value() == UserAction_t::Terminate) {
+        running = false;
+        return;
+      }
+      // A full queue means the game loop stalled; the key is dropped
+      game_loop.PushInput(action.value(), false);
+    }
+  }
+}
+
+int BrickGameConsoleView::BannerMask(const GameSnapshot &current_game_info) {
+  return (current_game_info.level == 0) | (current_game_info.pause << 1) |
+         ((current_game_info.level == kLoose) << 2) |
+         ((current_game_info.level == kWin) << 3);
+}
+
 void BrickGameConsoleView::StartEventLoop() {
   NCursesWrapper nc;
-  NcInit(10);
-  controller->UpdateCurrentState();
-
-  // auto frame_start_in_ms = std::chrono::system_clock::now();
-
-  while (true) {
-    PrintOverlay();
-    nc.refresh();
-    auto input = GetUserInput();
-    if (input) {
-      if (input.value() == UserAction_t::Terminate) {
-        break;
+  NcInit(0);
+
+  running = true;
+  GameLoop game_loop(controller);
+  std::thread input_thread(&BrickGameConsoleView::ReadInput, this,
+                           std::ref(game_loop));
+  auto next_frame = std::chrono::steady_clock::now();
+  int shown_banners = -1;
+  while (running) {
+    const GameSnapshot &current_game_info = game_loop.Frame();
+    // Banners cover board cells, so showing or hiding one repaints them all
+    int banners = BannerMask(current_game_info);
+    uint32_t rows = banners == shown_banners ? current_game_info.dirty_rows
+                                             : kAllRowsDirty;
+    shown_banners = banners;
+    {
+      std::lock_guard<std::mutex> lock(curses_mutex);
+      PrintOverlay();
+      PrintGameBoard(current_game_info, rows);
+      PrintNextFigure(current_game_info);
+      PrintStats(current_game_info);
+      if (current_game_info.level == 0) {
+        PrintBanner(std::string{"'s' to start"});
       }
-      userInput(input.value(), false);
-    }
-    controller->UpdateCurrentState();
-    GameInfo_t current_game_info = updateCurrentState();
-    PrintGameBoard(current_game_info);
-    PrintNextFigure(current_game_info);
-    PrintStats(current_game_info);
-    if (current_game_info.level == 0) {
-      PrintBanner(std::string{"'s' to start"});
-    }
-    if (current_game_info.pause) {
-      PrintBanner(std::string{"PAUSED"});
-    } else if (current_game_info.level == kLoose) {
-      PrintBanner(std::string{"GAME OVER"});
-    } else if (current_game_info.level == kWin) {
-      PrintBanner(std::string{"YOU WIN"});
+      if (current_game_info.pause) {
+        PrintBanner(std::string{"PAUSED"});
+      } else if (current_game_info.level == kLoose) {
+        PrintBanner(std::string{"GAME OVER"});
+      } else if (current_game_info.level == kWin) {
+        PrintBanner(std::string{"YOU WIN"});
+      }
+      nc.refresh();
     }
+    // A late frame does not make the following ones catch up
+    next_frame = std::max(next_frame + std::chrono::milliseconds(kFrameInMs),
+                          std::chrono::steady_clock::now());
+    std::this_thread::sleep_until(next_frame);
   }
+  input_thread.join();
 }
 
 void NcInit(int time) {
@@ -4,15 +4,19 @@
 #include <libgen.h>
 #include <ncurses.h>
 
+#include <atomic>
 #include <chrono>
 #include <iostream>
+#include <mutex>
 #include <optional>
 
 #include "../../brick_game/common.h"
 #include "../../brick_game/controller.h"
+#include "../../brick_game/game_loop.h"
 
 namespace s21 {
 constexpr int kBoardOffset = 2;
+constexpr int kFrameInMs = 10;
 
 constexpr int kHUDWidth = 18;
 constexpr int kMapPadding = 1;
@@ -59,18 +63,24 @@ class NCursesWrapper {
 class BrickGameConsoleView {
  private:
   Controller *controller;
+  // ncurses is not thread-safe: held around every curses call
+  std::mutex curses_mutex;
+  std::atomic<bool> running{false};
+
+  void ReadInput(GameLoop &game_loop);
 
  public:
   explicit BrickGameConsoleView(Controller *c) : controller(c) {}
   void StartEventLoop();
 
-  std::optional<UserAction_t> GetUserInput();
+  static std::optional<UserAction_t> KeyToAction(int ch);
+  static int BannerMask(const GameSnapshot &current_game_info);
 
   void PrintOverlay(void);
   void PrintFrame(int top_y, int bottom_y, int left_x, int right_x);
-  void PrintGameBoard(const GameInfo_t &current_game_info);
-  void PrintNextFigure(const GameInfo_t &current_game_info);
-  void PrintStats(const GameInfo_t &current_game_info);
+  void PrintGameBoard(const GameSnapshot &current_game_info, uint32_t rows);
+  void PrintNextFigure(const GameSnapshot &current_game_info);
+  void PrintStats(const GameSnapshot &current_game_info);
   void PrintBanner(std::string &&banner_text);
 };
 
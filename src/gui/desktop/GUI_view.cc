@@ -4,11 +4,11 @@
 
 namespace s21 {
 
-GUIView::GUIView(s21::Controller* c) : controller(c) {
+GUIView::GUIView(s21::Controller* c) : game_loop(c) {
   set_title("Brick Game");
   set_default_size(kWindowWidth, kWindowHeigth);
 
-  controller->UpdateCurrentState();
+  frame = &game_loop.Frame();
 
   outer_box.set_orientation(Gtk::Orientation::VERTICAL);
   set_child(outer_box);
@@ -42,10 +42,19 @@ GUIView::GUIView(s21::Controller* c) : controller(c) {
 }
 
 bool GUIView::OnTimeout() {
-  controller->UpdateCurrentState();
-  auto currentGameState = updateCurrentState();
+  // The draw functions queued below paint this same frame
+  frame = &game_loop.Frame();
+  if (frame->sequence == shown_sequence) {
+    return true;
+  }
+  shown_sequence = frame->sequence;
+  const auto &currentGameState = *frame;
   message_label->set_text(GetStatusMessage());
-  game_canvas->queue_draw();
+  // GTK 4 repaints a drawing area as a whole, so the board is skipped only
+  // when none of its rows changed
+  if (currentGameState.dirty_rows != 0) {
+    game_canvas->queue_draw();
+  }
   next_canvas->queue_draw();
   level_value->set_text(
       std::to_string(currentGameState.level > 0 ? currentGameState.level : 0));
@@ -61,7 +70,7 @@ void GUIView::SetupGameGrid() {
   game_canvas->set_draw_func([this](const Cairo::RefPtr<Cairo::Context>& cr,
                                     [[maybe_unused]] int width,
                                     [[maybe_unused]] int height) {
-    auto currentGameState = updateCurrentState();
+    const auto &currentGameState = *frame;
     cr->set_source_rgb(0.1f, 0.1f, 0.1f);
     cr->paint();
     for (int row = 0; row < kFieldHeight; ++row) {
@@ -87,13 +96,13 @@ void GUIView::SetupNextFigureGrid() {
   next_canvas->set_draw_func([this](const Cairo::RefPtr<Cairo::Context>& cr,
                                     [[maybe_unused]] int width,
                                     [[maybe_unused]] int height) {
-    auto currentGameState = updateCurrentState();
+    const auto &currentGameState = *frame;
     cr->set_source_rgb(0.1f, 0.1f, 0.1f);
     cr->paint();
     for (int row = 0; row < kNextFieldHeight; ++row) {
       for (int col = 0; col < kNextFieldWidth; ++col) {
         const auto [r, g, b] = kColorMap.at(
-            currentGameState.next ? currentGameState.next[row][col] : 0);
+            currentGameState.has_next ? currentGameState.next[row][col] : 0);
         cr->set_source_rgb(r, g, b);
         cr->rectangle(col * kBlockOnScreenSize + kBlockOnScreenMargin,
                       row * kBlockOnScreenSize + kBlockOnScreenMargin,
@@ -118,7 +127,7 @@ void GUIView::SetupInfoPanel() {
   info_panel.set_margin_start(20);
   info_panel.set_margin_end(20);
 
-  auto currentGameState = updateCurrentState();
+  const auto &currentGameState = *frame;
   // Level
   auto level_box = Gtk::make_managed<Gtk::Box>(Gtk::Orientation::VERTICAL);
   auto level_label = Gtk::make_managed<Gtk::Label>("LEVEL");
@@ -227,14 +236,14 @@ bool GUIView::OnWindowKeyPressed(guint keyval, guint,
     this->close();
     return false;
   }
-  userInput(action, false);
-  controller->UpdateCurrentState();
+  // A full queue means the game loop stalled; the key is dropped
+  game_loop.PushInput(action, false);
   return false;
 }
 
 std::string GUIView::GetStatusMessage() {
   std::string status_message = "";
-  auto currentGameState = updateCurrentState();
+  const auto &currentGameState = *frame;
   if (currentGameState.level == kStart) {
     status_message = "Press S to start";
   } else if (currentGameState.level == kWin) {
@@ -17,6 +17,7 @@
 #include <tuple>
 
 #include "../../brick_game/controller.h"
+#include "../../brick_game/game_loop.h"
 
 namespace s21 {
 
@@ -40,7 +41,10 @@ const std::map<int, std::tuple<float, float, float>> kColorMap = {
 
 class GUIView : public Gtk::Window {
  private:
-  s21::Controller *controller;
+  // Runs the controller on its own thread; the view only reads its frames
+  s21::GameLoop game_loop;
+  const GameSnapshot *frame = nullptr;
+  uint64_t shown_sequence = 0;
   Gtk::Box outer_box;
   Gtk::Box main_box;          // Main container
   Gtk::Grid game_grid;        // Game board grid (20x10)
@@ -0,0 +1,203 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "brick_game/snake/snake_autopilot.h"
+#include "brick_game/snake/snake_model.h"
+#include "brick_game/snake/snake_policy.h"
+#include "brick_game/snake/snake_replay.h"
+#include "brick_game/snake/snake_replay_player.h"
+#include "brick_game/work_stealing_pool.h"
+
+namespace {
+
+constexpr int kLengthBucket = 20;
+
+struct Options {
+  int games = 1000;
+  std::size_t threads = 0;
+  uint32_t seed = 1;
+  std::string policy = "greedy";
+  int64_t max_ticks = 10000000;
+  std::string record_dir;
+  std::string replay_file;
+};
+
+struct GameResult {
+  int score = 0;
+  int length = 0;
+  bool win = false;
+  int64_t moves = 0;
+};
+
+std::unique_ptr<s21::SnakePolicy> MakePolicy(const std::string &name,
+                                             uint32_t seed) {
+  if (name == "random") {
+    return std::make_unique<s21::RandomPolicy>(seed);
+  }
+  if (name == "greedy") {
+    return std::make_unique<s21::GreedyPolicy>();
+  }
+  if (name == "autopilot") {
+    return std::make_unique<s21::AutopilotPolicy>();
+  }
+  return nullptr;
+}
+
+GameResult PlayGame(const Options &options, uint32_t seed) {
+  s21::SnakeModel model("", nullptr, seed);
+  auto policy = MakePolicy(options.policy, seed);
+  GameResult result;
+
+  s21::SnakeReplay replay;
+  if (!options.record_dir.empty()) {
+    model.SetRecorder(&replay);
+  }
+
+  model.SetPilot(policy.get());
+  model.FSM(UserAction_t::Start);
+  for (int64_t ticks = 0; model.GetGameState() == s21::GameState::kRunning &&
+                          ticks < options.max_ticks;
+       ++ticks) {
+    result.moves += model.Tick();
+  }
+
+  result.score = model.GetScore();
+  result.length = model.GetLength();
+  result.win = model.GetLevel() == kWin;
+
+  if (!options.record_dir.empty()) {
+    auto path = std::filesystem::path(options.record_dir) /
+                ("snake_" + std::to_string(seed) + ".replay");
+    if (!replay.SaveToFile(path)) {
+      std::fprintf(stderr, "cannot write %s\n", path.c_str());
+    }
+  }
+  return result;
+}
+
+int PlayReplay(const std::string &file) {
+  s21::SnakeReplay replay;
+  if (!replay.LoadFromFile(file)) {
+    std::fprintf(stderr, "cannot read replay %s\n", file.c_str());
+    return 1;
+  }
+
+  s21::SnakeReplayPlayer player(replay);
+  auto start = std::chrono::steady_clock::now();
+  if (!player.Run()) {
+    std::fprintf(stderr, "replay %s was recorded on a %dx%d field\n",
+                 file.c_str(), replay.GetWidth(), replay.GetHeight());
+    return 1;
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+  const auto &model = player.GetModel();
+  std::printf("seed            %u\n", replay.GetSeed());
+  std::printf("ticks           %lld\n",
+              static_cast<long long>(replay.GetEndTick()));
+  std::printf("inputs          %zu (%zu bytes)\n", replay.GetInputCount(),
+              replay.GetInputBytes().size());
+  std::printf("score           %d\n", model.GetScore());
+  std::printf("length          %d\n", model.GetLength());
+  std::printf("ticks/sec       %.0f\n", replay.GetEndTick() / seconds);
+  return 0;
+}
+
+bool ParseOptions(int argc, char *argv[], Options &options) {
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (std::strcmp(argv[i], "--games") == 0) {
+      options.games = std::atoi(argv[i + 1]);
+    } else if (std::strcmp(argv[i], "--threads") == 0) {
+      options.threads = std::strtoul(argv[i + 1], nullptr, 10);
+    } else if (std::strcmp(argv[i], "--seed") == 0) {
+      options.seed = std::strtoul(argv[i + 1], nullptr, 10);
+    } else if (std::strcmp(argv[i], "--policy") == 0) {
+      options.policy = argv[i + 1];
+    } else if (std::strcmp(argv[i], "--max-ticks") == 0) {
+      options.max_ticks = std::atoll(argv[i + 1]);
+    } else if (std::strcmp(argv[i], "--record") == 0) {
+      options.record_dir = argv[i + 1];
+    } else if (std::strcmp(argv[i], "--replay") == 0) {
+      options.replay_file = argv[i + 1];
+    } else {
+      return false;
+    }
+  }
+  return argc % 2 == 1 && options.games > 0 &&
+         MakePolicy(options.policy, 0) != nullptr;
+}
+
+void PrintReport(const Options &options, std::size_t threads,
+                 const std::vector<GameResult> &results, double seconds) {
+  int64_t total_score = 0;
+  int64_t total_moves = 0;
+  int wins = 0;
+  std::vector<int> buckets(s21::kSnakeSizeToWin / kLengthBucket + 1, 0);
+  for (const auto &result : results) {
+    total_score += result.score;
+    total_moves += result.moves;
+    wins += result.win;
+    buckets[result.length / kLengthBucket]++;
+  }
+
+  std::printf("policy          %s\n", options.policy.c_str());
+  std::printf("games           %d\n", options.games);
+  std::printf("threads         %zu\n", threads);
+  std::printf("wall time       %.3f s\n", seconds);
+  std::printf("games/sec       %.1f\n", options.games / seconds);
+  std::printf("moves/sec       %.0f\n", total_moves / seconds);
+  std::printf("mean score      %.2f\n",
+              static_cast<double>(total_score) / options.games);
+  std::printf("wins            %d\n", wins);
+  std::printf("length distribution:\n");
+  for (std::size_t i = 0; i < buckets.size(); ++i) {
+    if (buckets[i] == 0) continue;
+    std::printf("  [%3zu, %3zu)  %6.2f%%  %d\n", i * kLengthBucket,
+                (i + 1) * kLengthBucket, 100.0 * buckets[i] / options.games,
+                buckets[i]);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  Options options;
+  if (!ParseOptions(argc, argv, options)) {
+    std::fprintf(stderr,
+                 "usage: %s [--games N] [--threads N] [--seed N] "
+                 "[--policy random|greedy|autopilot] [--max-ticks N] "
+                 "[--record DIR] [--replay FILE]\n",
+                 argv[0]);
+    return 1;
+  }
+  if (!options.replay_file.empty()) {
+    return PlayReplay(options.replay_file);
+  }
+
+  std::vector<GameResult> results(options.games);
+  auto start = std::chrono::steady_clock::now();
+  std::size_t threads = 0;
+  {
+    s21::WorkStealingPool pool(options.threads);
+    threads = pool.Size();
+    for (int i = 0; i < options.games; ++i) {
+      pool.Submit([&options, &results, i] {
+        results[i] = PlayGame(options, options.seed + i);
+      });
+    }
+    pool.Wait();
+  }
+  auto stop = std::chrono::steady_clock::now();
+
+  PrintReport(options, threads, results,
+              std::chrono::duration<double>(stop - start).count());
+  return 0;
+}
@@ -0,0 +1,232 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "brick_game/game_clock.h"
+#include "brick_game/tetris/tetris_controller.h"
+#include "brick_game/tetris/tetris_game_info_t_raii.h"
+#include "brick_game/tetris/tetris_search.h"
+
+namespace {
+
+struct Options {
+  int64_t ticks = 1000000;
+  uint64_t seed = 1;
+  std::string script;
+};
+
+/**
+ * Plays like the autoplay mode: picks the best placement for every new piece
+ * and walks it there one input per tick. The path is replanned from where
+ * gravity left the piece, and the piece is hard dropped once only downward
+ * moves remain.
+ */
+class AiInput {
+ public:
+  std::optional<UserAction_t> Next(game_state state, const board_t &board) {
+    if (state != MOVING) {
+      has_target_ = false;
+      return UserAction_t::Down;  // Moves the game through attach and spawn
+    }
+    const tetramino_t &piece = board.tetramino_curr;
+    if (!has_target_) {
+      placement_t best;
+      if (find_best_placement(&board, &piece, weighted_heuristic,
+                              &default_heuristic_weights, &best) == 0)
+        return UserAction_t::Up;
+      target_ = best.tetramino;
+      has_target_ = true;
+    }
+
+    int count = plan_placement_moves(&board, &piece, &target_, moves_);
+    int first = 0;
+    while (first < count && moves_[first] == MOVE_DOWN) ++first;
+    if (count <= 0 || first == count) return UserAction_t::Up;
+    switch (moves_[0]) {
+      case MOVE_LEFT:
+        return UserAction_t::Left;
+      case MOVE_RIGHT:
+        return UserAction_t::Right;
+      case ACTION_BTN:
+        return UserAction_t::Action;
+      default:
+        return UserAction_t::Down;
+    }
+  }
+
+ private:
+  tetramino_t target_ = {};
+  bool has_target_ = false;
+  signals moves_[SEARCH_STATES];
+};
+
+/**
+ * Replays a fixed input script in a loop, one character per tick: L, R, D,
+ * U and A for left, right, down, hard drop and rotate, '.' for an idle tick.
+ * Other characters are skipped.
+ */
+class ScriptInput {
+ public:
+  explicit ScriptInput(std::string script) {
+    for (char c : script)
+      if (std::strchr("LRDUA.", c) != nullptr) script_.push_back(c);
+  }
+
+  bool Empty() const { return script_.empty(); }
+
+  std::optional<UserAction_t> Next(game_state, const board_t &) {
+    char c = script_[pos_];
+    pos_ = (pos_ + 1) % script_.size();
+    switch (c) {
+      case 'L':
+        return UserAction_t::Left;
+      case 'R':
+        return UserAction_t::Right;
+      case 'D':
+        return UserAction_t::Down;
+      case 'U':
+        return UserAction_t::Up;
+      case 'A':
+        return UserAction_t::Action;
+      default:
+        return std::nullopt;
+    }
+  }
+
+ private:
+  std::string script_;
+  std::size_t pos_ = 0;
+};
+
+struct SimResult {
+  int64_t ticks = 0;
+  int games = 0;
+  int64_t pieces = 0;
+  int64_t score = 0;
+  std::vector<int64_t> tick_ns;
+};
+
+/**
+ * Runs the game the way the views do, one frame per tick of a manual clock:
+ * the input of the tick, then the controller update with its gravity drops
+ * and the GameInfo_t render. A finished game is restarted until the tick
+ * budget runs out.
+ */
+template <class Input>
+SimResult Simulate(const Options &options, Input &input) {
+  GameInfo game_info;
+  board_t board = {};
+  init_board_seeded(&board, options.seed, RANDOMIZER_BAG7);
+  game_stats_t stats;
+  init_transient_stats(&stats);
+  game_state state = START;
+  s21::ManualGameClock clock(std::chrono::milliseconds(s21::kTetrisTickInMs));
+  s21::TetrisController controller(game_info.get(), &state, &board, &stats,
+                                   &clock);
+
+  SimResult result;
+  result.tick_ns.reserve(options.ticks);
+  bool between_pieces = true;
+  controller.processUserInput(UserAction_t::Start, false);
+  for (; result.ticks < options.ticks; ++result.ticks) {
+    clock.Step();
+    auto start = std::chrono::steady_clock::now();
+    std::optional<UserAction_t> action =
+        state == GAMEOVER ? UserAction_t::Start : input.Next(state, board);
+    if (state == GAMEOVER) {
+      result.games++;
+      result.score += stats.score;
+    }
+    if (action) controller.processUserInput(*action, false);
+    controller.UpdateCurrentState();
+    auto stop = std::chrono::steady_clock::now();
+    result.tick_ns.push_back(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+            .count());
+
+    // Every piece passes through attaching or spawning before it moves
+    if (state == MOVING && between_pieces) result.pieces++;
+    between_pieces = state == ATTACHING || state == SPAWN;
+  }
+  result.games++;
+  result.score += stats.score;
+  return result;
+}
+
+int64_t Percentile(std::vector<int64_t> &values, double share) {
+  auto index = static_cast<std::ptrdiff_t>(
+      share * static_cast<double>(values.size() - 1));
+  auto nth = values.begin() + index;
+  std::nth_element(values.begin(), nth, values.end());
+  return *nth;
+}
+
+bool ParseOptions(int argc, char *argv[], Options &options) {
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (std::strcmp(argv[i], "--ticks") == 0) {
+      options.ticks = std::atoll(argv[i + 1]);
+    } else if (std::strcmp(argv[i], "--seed") == 0) {
+      options.seed = std::strtoull(argv[i + 1], nullptr, 10);
+    } else if (std::strcmp(argv[i], "--script") == 0) {
+      options.script = argv[i + 1];
+    } else {
+      return false;
+    }
+  }
+  return argc % 2 == 1 && options.ticks > 0;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  Options options;
+  if (!ParseOptions(argc, argv, options)) {
+    std::fprintf(stderr, "usage: %s [--ticks N] [--seed N] [--script FILE]\n",
+                 argv[0]);
+    return 1;
+  }
+
+  SimResult result;
+  auto start = std::chrono::steady_clock::now();
+  if (options.script.empty()) {
+    AiInput input;
+    result = Simulate(options, input);
+  } else {
+    std::ifstream fs(options.script);
+    ScriptInput input(std::string((std::istreambuf_iterator<char>(fs)),
+                                  std::istreambuf_iterator<char>()));
+    if (input.Empty()) {
+      std::fprintf(stderr, "cannot read script %s\n", options.script.c_str());
+      return 1;
+    }
+    result = Simulate(options, input);
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+  std::printf("input           %s\n",
+              options.script.empty() ? "ai" : options.script.c_str());
+  std::printf("ticks           %lld (%.1f s of game time)\n",
+              static_cast<long long>(result.ticks),
+              result.ticks * s21::kTetrisTickInMs / 1000.0);
+  std::printf("games           %d\n", result.games);
+  std::printf("pieces          %lld\n", static_cast<long long>(result.pieces));
+  std::printf("mean score      %.1f\n",
+              static_cast<double>(result.score) / result.games);
+  std::printf("wall time       %.3f s\n", seconds);
+  std::printf("ticks/sec       %.0f\n", result.ticks / seconds);
+  std::printf("pieces/sec      %.0f\n", result.pieces / seconds);
+  std::printf("tick p50        %lld ns\n",
+              static_cast<long long>(Percentile(result.tick_ns, 0.50)));
+  std::printf("tick p99        %lld ns\n",
+              static_cast<long long>(Percentile(result.tick_ns, 0.99)));
+  return 0;
+}
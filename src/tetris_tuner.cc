@@ -0,0 +1,297 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "brick_game/tetris/tetris_search.h"
+#include "brick_game/work_stealing_pool.h"
+
+namespace {
+
+constexpr char kCheckpointMagic[] = "tetris-tuner";
+constexpr int kCheckpointVersion = 1;
+// Share of the population replaced by offspring every generation
+constexpr double kOffspringShare = 0.3;
+// Share of the population drawn for each tournament
+constexpr double kTournamentShare = 0.1;
+constexpr double kMutationChance = 0.05;
+constexpr double kMutationStep = 0.2;
+
+struct Options {
+  int population = 100;
+  int generations = 10;
+  int games = 20;
+  long max_pieces = 500;
+  std::size_t threads = 0;
+  uint32_t seed = 1;
+  std::string checkpoint;
+  std::string resume;
+};
+
+constexpr int kGeneCount = 4;
+using Genes = std::array<double, kGeneCount>;
+
+struct Candidate {
+  Genes genes = {};
+  long lines = 0;
+};
+
+heuristic_weights_t ToWeights(const Genes &genes) {
+  return {.aggregate_height = genes[0],
+          .holes = genes[1],
+          .bumpiness = genes[2],
+          .lines_cleared = genes[3]};
+}
+
+void Normalize(Genes &genes) {
+  double norm = 0;
+  for (double gene : genes) norm += gene * gene;
+  norm = std::sqrt(norm);
+  if (norm == 0) return;
+  for (double &gene : genes) gene /= norm;
+}
+
+Genes RandomGenes(std::mt19937 &rng) {
+  std::uniform_real_distribution<double> value(-0.5, 0.5);
+  Genes genes;
+  for (double &gene : genes) gene = value(rng);
+  Normalize(genes);
+  return genes;
+}
+
+/**
+ * Picks the two fittest of a random sample of the population.
+ */
+std::pair<const Candidate *, const Candidate *> Tournament(
+    const std::vector<Candidate> &population, std::mt19937 &rng) {
+  std::size_t size = std::max<std::size_t>(
+      2, static_cast<std::size_t>(population.size() * kTournamentShare));
+  std::vector<std::size_t> sample(population.size());
+  for (std::size_t i = 0; i < sample.size(); ++i) sample[i] = i;
+  std::shuffle(sample.begin(), sample.end(), rng);
+  sample.resize(size);
+  std::sort(sample.begin(), sample.end(), [&](std::size_t a, std::size_t b) {
+    return population[a].lines > population[b].lines;
+  });
+  return {&population[sample[0]], &population[sample[1]]};
+}
+
+/**
+ * Blends two parents in proportion to their fitness, then occasionally
+ * nudges one gene.
+ */
+Genes Crossover(const Candidate &a, const Candidate &b, std::mt19937 &rng) {
+  double fa = static_cast<double>(a.lines) + 1;
+  double fb = static_cast<double>(b.lines) + 1;
+  Genes child;
+  for (int i = 0; i < kGeneCount; ++i)
+    child[i] = a.genes[i] * fa + b.genes[i] * fb;
+  Normalize(child);
+
+  std::uniform_real_distribution<double> unit(0, 1);
+  if (unit(rng) < kMutationChance) {
+    std::uniform_int_distribution<int> gene(0, kGeneCount - 1);
+    child[gene(rng)] += (unit(rng) * 2 - 1) * kMutationStep;
+    Normalize(child);
+  }
+  return child;
+}
+
+/**
+ * Writes the population to @p path through a temporary file, so a run
+ * interrupted mid-write keeps its previous checkpoint.
+ */
+bool SaveCheckpoint(const std::string &path, int generation,
+                    const std::vector<Candidate> &population) {
+  std::filesystem::path tmp_path = path;
+  tmp_path += ".tmp";
+  {
+    std::ofstream fs(tmp_path, std::ios::trunc);
+    fs << kCheckpointMagic << ' ' << kCheckpointVersion << '\n'
+       << generation << ' ' << population.size() << '\n';
+    fs.precision(17);
+    for (const Candidate &candidate : population) {
+      for (double gene : candidate.genes) fs << gene << ' ';
+      fs << candidate.lines << '\n';
+    }
+    if (!fs.good()) return false;
+  }
+  std::error_code error;
+  std::filesystem::rename(tmp_path, path, error);
+  return !error;
+}
+
+bool LoadCheckpoint(const std::string &path, int &generation,
+                    std::vector<Candidate> &population) {
+  std::ifstream fs(path);
+  std::string magic;
+  int version = 0;
+  std::size_t size = 0;
+  if (!(fs >> magic >> version >> generation >> size) ||
+      magic != kCheckpointMagic || version != kCheckpointVersion || size < 2)
+    return false;
+  population.assign(size, Candidate());
+  for (Candidate &candidate : population) {
+    for (double &gene : candidate.genes) fs >> gene;
+    fs >> candidate.lines;
+  }
+  return !fs.fail();
+}
+
+bool ParseOptions(int argc, char *argv[], Options &options) {
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (std::strcmp(argv[i], "--population") == 0) {
+      options.population = std::atoi(argv[i + 1]);
+    } else if (std::strcmp(argv[i], "--generations") == 0) {
+      options.generations = std::atoi(argv[i + 1]);
+    } else if (std::strcmp(argv[i], "--games") == 0) {
+      options.games = std::atoi(argv[i + 1]);
+    } else if (std::strcmp(argv[i], "--max-pieces") == 0) {
+      options.max_pieces = std::atol(argv[i + 1]);
+    } else if (std::strcmp(argv[i], "--threads") == 0) {
+      options.threads = std::strtoul(argv[i + 1], nullptr, 10);
+    } else if (std::strcmp(argv[i], "--seed") == 0) {
+      options.seed = std::strtoul(argv[i + 1], nullptr, 10);
+    } else if (std::strcmp(argv[i], "--checkpoint") == 0) {
+      options.checkpoint = argv[i + 1];
+    } else if (std::strcmp(argv[i], "--resume") == 0) {
+      options.resume = argv[i + 1];
+    } else {
+      return false;
+    }
+  }
+  return argc % 2 == 1 && options.population >= 2 && options.games > 0 &&
+         options.max_pieces > 0;
+}
+
+/**
+ * Plays every candidate on the same seeded games, spreading the
+ * (candidate, game) pairs over the pool. Returns the pieces played.
+ */
+long Evaluate(const Options &options, int generation,
+              std::vector<Candidate> &population, s21::WorkStealingPool &pool) {
+  std::vector<autoplay_result_t> results(population.size() * options.games);
+  for (std::size_t c = 0; c < population.size(); ++c) {
+    for (int g = 0; g < options.games; ++g) {
+      pool.Submit([&options, &population, &results, generation, c, g] {
+        uint64_t seed = (static_cast<uint64_t>(options.seed) << 32) +
+                        static_cast<uint64_t>(generation) * options.games + g;
+        // The board lives on the worker's stack, so games never share state
+        heuristic_weights_t weights = ToWeights(population[c].genes);
+        board_t board;
+        results[c * options.games + g] =
+            play_seeded_game(&board, seed, options.max_pieces,
+                             weighted_heuristic, &weights);
+      });
+    }
+  }
+  pool.Wait();
+
+  long pieces = 0;
+  for (std::size_t c = 0; c < population.size(); ++c) {
+    population[c].lines = 0;
+    for (int g = 0; g < options.games; ++g) {
+      population[c].lines += results[c * options.games + g].lines;
+      pieces += results[c * options.games + g].pieces;
+    }
+  }
+  std::sort(population.begin(), population.end(),
+            [](const Candidate &a, const Candidate &b) {
+              return a.lines > b.lines;
+            });
+  return pieces;
+}
+
+void Breed(std::vector<Candidate> &population, std::mt19937 &rng) {
+  std::size_t offspring = std::max<std::size_t>(
+      1, static_cast<std::size_t>(population.size() * kOffspringShare));
+  std::vector<Candidate> children(offspring);
+  for (Candidate &child : children) {
+    auto parents = Tournament(population, rng);
+    child.genes = Crossover(*parents.first, *parents.second, rng);
+  }
+  std::copy(children.begin(), children.end(),
+            population.end() - static_cast<std::ptrdiff_t>(offspring));
+}
+
+void PrintGenes(const Genes &genes) {
+  std::printf("  height %+.6f  holes %+.6f  bumpiness %+.6f  lines %+.6f\n",
+              genes[0], genes[1], genes[2], genes[3]);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  Options options;
+  if (!ParseOptions(argc, argv, options)) {
+    std::fprintf(stderr,
+                 "usage: %s [--population N] [--generations N] [--games N] "
+                 "[--max-pieces N] [--threads N] [--seed N] "
+                 "[--checkpoint FILE] [--resume FILE]\n",
+                 argv[0]);
+    return 1;
+  }
+
+  int generation = 0;
+  std::vector<Candidate> population;
+  if (!options.resume.empty()) {
+    if (!LoadCheckpoint(options.resume, generation, population)) {
+      std::fprintf(stderr, "cannot read checkpoint %s\n",
+                   options.resume.c_str());
+      return 1;
+    }
+  } else {
+    std::mt19937 rng(options.seed);
+    population.resize(options.population);
+    for (Candidate &candidate : population)
+      candidate.genes = RandomGenes(rng);
+  }
+
+  s21::WorkStealingPool pool(options.threads);
+  std::printf("population %zu, %d games of up to %ld pieces, %zu threads\n",
+              population.size(), options.games, options.max_pieces,
+              pool.Size());
+  long total_pieces = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int end = generation + options.generations; generation < end;) {
+    auto gen_start = std::chrono::steady_clock::now();
+    long pieces = Evaluate(options, generation, population, pool);
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - gen_start)
+                         .count();
+    total_pieces += pieces;
+
+    long sum = 0;
+    for (const Candidate &candidate : population) sum += candidate.lines;
+    std::printf("gen %4d  best %8.1f  mean %8.1f lines/game  %9.0f pieces/s\n",
+                generation, static_cast<double>(population[0].lines) /
+                                options.games,
+                static_cast<double>(sum) / population.size() / options.games,
+                pieces / seconds);
+    PrintGenes(population[0].genes);
+
+    // Seeding per generation keeps a resumed run on the same track
+    std::mt19937 rng(options.seed + static_cast<uint32_t>(generation));
+    Breed(population, rng);
+    ++generation;
+    if (!options.checkpoint.empty() &&
+        !SaveCheckpoint(options.checkpoint, generation, population))
+      std::fprintf(stderr, "cannot write %s\n", options.checkpoint.c_str());
+  }
+
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  std::printf("pieces          %ld\n", total_pieces);
+  std::printf("wall time       %.3f s\n", seconds);
+  std::printf("pieces/sec      %.0f\n", total_pieces / seconds);
+  return 0;
+}